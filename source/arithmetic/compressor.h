@@ -28,6 +28,8 @@ private:
 	commons::io::binary_destination &binary_destination;
 
 	int underflow;
+
+	void emit_run(bool bit, int count);
 public:
 
 	/**
@@ -79,7 +81,6 @@ void arithmetic::compressor<PRECISION>::compress(const symbol &s, const symbol_d
 	_floor = r.new_floor;
 	_roof = r.new_roof;
 
-	std::string emission;
 	LOG_DEBUG("Normalized");
 	LOG_DEBUG_VAR(r.new_floor);
 	LOG_DEBUG_VAR(r.new_roof);
@@ -88,19 +89,16 @@ void arithmetic::compressor<PRECISION>::compress(const symbol &s, const symbol_d
 
 	if (!r.overflow.empty()) {
 		binary_destination.emit_bit(r.overflow[0]);
-		emission += r.overflow[0] ? "1" : "0";
-
-		for (int i = 0; i < underflow; i++) {
-			binary_destination.emit_bit(!r.overflow[0]);
-			emission += !r.overflow[0] ? "1" : "0";
-		}
-
+		emit_run(!r.overflow[0], underflow);
 		underflow = 0;
 
+		// El resto de los bits de overflow (a lo sumo PRECISION)
+		// se emiten de una vez
+		uint64_t overflow_bits = 0;
 		for (size_t i = 1; i < r.overflow.size(); i++) {
-			binary_destination.emit_bit(r.overflow[i]);
-			emission += r.overflow[i] ? "1" : "0";
+			overflow_bits = (overflow_bits << 1) | (r.overflow[i] ? 1 : 0);
 		}
+		binary_destination.emit_bits(overflow_bits, r.overflow.size() - 1);
 	}
 
 	underflow += r.underflow;
@@ -111,14 +109,23 @@ void arithmetic::compressor<PRECISION>::finish_compression(){
 	LOG_DEBUG("Finish compression");
 	LOG_DEBUG_VAR(_floor.to_string());
 	binary_destination.emit_bit(_floor[PRECISION - 1]);
-
-	for (int i = 0; i < underflow; i++) {
-		binary_destination.emit_bit( !_floor[PRECISION - 1] );
-	}
+	emit_run(!_floor[PRECISION - 1], underflow);
 	underflow = 0;
-	for (int i = PRECISION - 2; i >= 0; i--) {
-		binary_destination.emit_bit(_floor[i]);
+
+	// Los bits restantes del piso, del más significativo al menos
+	uint64_t floor_bits = _floor.to_ulong() & ((static_cast<uint64_t>(1) << (PRECISION - 1)) - 1);
+	binary_destination.emit_bits(floor_bits, PRECISION - 1);
+}
+
+template<int PRECISION>
+void arithmetic::compressor<PRECISION>::emit_run(bool bit, int count) {
+	// Los bits pendientes por underflow son todos iguales, así
+	// que se emiten de a 64
+	uint64_t bits = bit ? ~static_cast<uint64_t>(0) : 0;
+	for (; count > 64; count -= 64) {
+		binary_destination.emit_bits(bits, 64);
 	}
+	binary_destination.emit_bits(bits, count);
 }
 
 }
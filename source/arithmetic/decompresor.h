@@ -29,9 +29,11 @@ private:
 
 	commons::io::binary_source &binary_source;
 
-	std::vector<bool> current;
+	// Los PRECISION bits de la entrada que se están decodificando,
+	// con el primero como el más significativo
+	unsigned long current;
 
-	bool get_bit_from_source();
+	unsigned long get_bits_from_source(int count);
 public:
 	/**
 	* Crea una nueva instancia de decompresor que tomará bits
@@ -49,16 +51,14 @@ public:
 template<int PRECISION>
 decompressor<PRECISION>::decompressor(commons::io::binary_source &source)
 : _floor(0), _roof(static_cast<unsigned long>(std::pow(2, PRECISION) - 1)), binary_source(source) {
-	for (int i = 0; i < PRECISION; i++) {
-		current.push_back(get_bit_from_source());
-	}
-	LOG_DEBUG(commons::utils::bit::to_bit_string(current));
+	current = get_bits_from_source(PRECISION);
+	LOG_DEBUG(commons::utils::bit::to_bit_string<PRECISION>(current));
 }
 
 template<int PRECISION>
 symbol decompressor<PRECISION>::decompress(const symbol_distribution &distribution) {
 	unsigned long interval = _roof.to_ulong() - _floor.to_ulong() + 1;
-	unsigned long compare_value = commons::utils::bit::to_unsigned_long<PRECISION>(current);
+	unsigned long compare_value = current;
 	LOG_DEBUG("Decompressing next distribution");
 	LOG_DEBUG_VAR(distribution);
 
@@ -84,15 +84,16 @@ symbol decompressor<PRECISION>::decompress(const symbol_distribution &distributi
 			LOG_DEBUG_VAR(result.overflow.size());
 			LOG_DEBUG_VAR(result.underflow);
 
-			for (std::size_t i = 0; i < result.overflow.size(); i++) {
-				current.erase(current.begin());
-				current.push_back(get_bit_from_source());
-			}
+			// Los bits de overflow salen por la izquierda
+			const unsigned long mask = (static_cast<unsigned long>(1) << PRECISION) - 1;
+			int overflow = result.overflow.size();
+			current = ((current << overflow) | get_bits_from_source(overflow)) & mask;
 
-			for (int i = 0; i < result.underflow; i++) {
-				current.erase(current.begin() + 1);
-				current.push_back(get_bit_from_source());
-			}
+			// Los de underflow se sacan a continuación del más
+			// significativo, que se mantiene
+			int underflow = result.underflow;
+			unsigned long top_bit = current & (static_cast<unsigned long>(1) << (PRECISION - 1));
+			current = top_bit | ((current << underflow) & (mask >> 1)) | get_bits_from_source(underflow);
 
 			LOG_DEBUG_VAR(current_symbol);
 			return current_symbol;
@@ -103,10 +104,10 @@ symbol decompressor<PRECISION>::decompress(const symbol_distribution &distributi
 }
 
 template<int PRECISION>
-bool decompressor<PRECISION>::get_bit_from_source() {
-	std::pair<bool, bool> result = binary_source.get_next_bit();
+unsigned long decompressor<PRECISION>::get_bits_from_source(int count) {
+	std::pair<bool, uint64_t> result = binary_source.read_bits(count);
 	ASSERTION_WITH_MESSAGE(result.first, "Unexpected end of binary stream");
-	return result.second;
+	return static_cast<unsigned long>(result.second);
 }
 
 };
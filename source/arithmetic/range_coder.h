@@ -0,0 +1,32 @@
+/******************************************************************************
+ * range_coder.h
+ * 		Constantes compartidas por arithmetic::range_compressor y
+ * 		arithmetic::range_decompressor
+******************************************************************************/
+#ifndef __ARITHMETIC_RANGE_CODER_H_INCLUDED__
+#define __ARITHMETIC_RANGE_CODER_H_INCLUDED__
+
+/**
+ * Cota inferior del rango luego de normalizar. Cada vez que el
+ * rango cae por debajo de este valor se emite (o se consume) un
+ * byte completo y el rango se desplaza 8 bits.
+ */
+#define ARITHMETIC_RANGE_CODER_TOP (1u << 24)
+
+/**
+ * Cota (exclusiva) de la frecuencia total que puede tener una
+ * distribución para ser codificada. Dado que luego de normalizar el
+ * rango es al menos ARITHMETIC_RANGE_CODER_TOP, cada unidad de
+ * frecuencia recibe al menos una unidad del rango. El codificador no
+ * reescala las frecuencias: depende de que symbol_distribution las
+ * divida a la mitad al superar ARITHMETIC_DISTRIBUTION_RESCALE_LIMIT.
+ */
+#define ARITHMETIC_RANGE_CODER_MAX_TOTAL ARITHMETIC_RANGE_CODER_TOP
+
+/**
+ * Cantidad de bytes con los que se inicializa el decodificador y
+ * que emite el codificador al terminar.
+ */
+#define ARITHMETIC_RANGE_CODER_FLUSH_BYTES 5
+
+#endif
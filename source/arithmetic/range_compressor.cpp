@@ -0,0 +1,76 @@
+/******************************************************************************
+ * range_compressor.cpp
+ * 		Definiciones de la clase arithmetic::range_compressor
+******************************************************************************/
+#include "range_compressor.h"
+#include "../commons/assertions/assertions.h"
+#include "../commons/log/log.h"
+
+using namespace arithmetic;
+
+#if ARITHMETIC_DISTRIBUTION_RESCALE_LIMIT >= ARITHMETIC_RANGE_CODER_MAX_TOTAL
+#error "ARITHMETIC_DISTRIBUTION_RESCALE_LIMIT supera la frecuencia total que admite el range coder"
+#endif
+
+range_compressor::range_compressor(commons::io::binary_destination &destination)
+: binary_destination(destination), low(0), range(0xFFFFFFFFu), cache(0), cache_size(1) {
+
+}
+
+void range_compressor::compress(const symbol &s, const symbol_distribution &distribution) {
+	LOG_DEBUG("Compressing next symbol");
+	LOG_DEBUG_VAR(s.get_sequential_code());
+
+	encode(distribution.get_accumulated_frequency(s), distribution.get_emissions(s), distribution.get_total_frequency());
+}
+
+void range_compressor::compress(const symbol &s, const symbol_distribution::excluded_view &distribution) {
+	LOG_DEBUG("Compressing next symbol with exclusions");
+	LOG_DEBUG_VAR(s.get_sequential_code());
+
+	encode(distribution.get_accumulated_frequency(s), distribution.get_emissions(s), distribution.get_total_frequency());
+}
+
+void range_compressor::encode(uint32_t start, uint32_t size, uint32_t total) {
+	ASSERTION(size > 0);
+	ASSERTION(total < ARITHMETIC_RANGE_CODER_MAX_TOTAL);
+
+	// Achico el intervalo al subintervalo del símbolo
+	range /= total;
+	low += static_cast<uint64_t>(start) * range;
+	range *= size;
+
+	// Normalizo de a un byte por vez
+	while (range < ARITHMETIC_RANGE_CODER_TOP) {
+		range <<= 8;
+		shift_low();
+	}
+}
+
+void range_compressor::finish_compression() {
+	LOG_DEBUG("Finish compression");
+	for (int i = 0; i < ARITHMETIC_RANGE_CODER_FLUSH_BYTES; i++) {
+		shift_low();
+	}
+}
+
+void range_compressor::shift_low() {
+	// Sólo puedo emitir el byte alto cuando sé que ya no lo va
+	// a modificar un acarreo. Mientras tanto, los bytes 0xFF se
+	// acumulan en cache_size.
+	if (static_cast<uint32_t>(low) < 0xFF000000u || (low >> 32) != 0) {
+		unsigned char carry = static_cast<unsigned char>(low >> 32);
+		unsigned char pending = cache;
+		do {
+			emit_byte(static_cast<unsigned char>(pending + carry));
+			pending = 0xFF;
+		} while (--cache_size != 0);
+		cache = static_cast<unsigned char>(static_cast<uint32_t>(low) >> 24);
+	}
+	cache_size++;
+	low = (low & 0x00FFFFFFu) << 8;
+}
+
+void range_compressor::emit_byte(unsigned char byte) {
+	binary_destination.emit_bits(byte, 8);
+}
@@ -0,0 +1,70 @@
+/******************************************************************************
+ * range_compressor.h
+ * 		Declaraciones de la clase arithmetic::range_compressor
+******************************************************************************/
+#ifndef __ARITHMETIC_RANGE_COMPRESSOR_H_INCLUDED__
+#define __ARITHMETIC_RANGE_COMPRESSOR_H_INCLUDED__
+
+#include "../commons/io/binary_destination.h"
+#include "symbol_distribution.h"
+#include "range_coder.h"
+#include <stdint.h>
+
+namespace arithmetic {
+
+/**
+ * Compresor aritmético por rangos. A diferencia de
+ * arithmetic::compressor trabaja sólamente con aritmética
+ * entera sobre las frecuencias acumuladas de la distribución
+ * (piso 64 bits, rango 32 bits) y normaliza de a un byte por
+ * vez, por lo que la salida es idéntica en cualquier plataforma.
+ * La frecuencia total de las distribuciones tiene que ser menor a
+ * ARITHMETIC_RANGE_CODER_MAX_TOTAL (2^24), lo que está garantizado
+ * por el reescalado de symbol_distribution.
+ */
+class range_compressor {
+private:
+	commons::io::binary_destination &binary_destination;
+
+	uint64_t low;
+
+	uint32_t range;
+
+	unsigned char cache;
+
+	uint64_t cache_size;
+
+	void shift_low();
+
+	void emit_byte(unsigned char byte);
+
+	void encode(uint32_t start, uint32_t size, uint32_t total);
+public:
+	/**
+	 * Crea una nueva instancia de range_compressor que emite
+	 * bits a un binary_destination dado
+	 */
+	range_compressor(commons::io::binary_destination &destination);
+
+	/**
+	 * Comprime un simbolo dada una distribución de probabilidades de
+	 * símbolos. Dicha distribución DEBE contener al símbolo que se quiere
+	 * comprimir. Emite bits en el binary_destination asociado.
+	 */
+	void compress(const symbol &s, const symbol_distribution &distribution);
+
+	/**
+	 * Comprime un símbolo dada una vista con exclusiones de una
+	 * distribución, que DEBE contener al símbolo sin excluir.
+	 */
+	void compress(const symbol &s, const symbol_distribution::excluded_view &distribution);
+
+	/**
+	 * Termina la compresion, emitiendo los bytes pendientes.
+	 */
+	void finish_compression();
+};
+
+};
+
+#endif
@@ -0,0 +1,64 @@
+/******************************************************************************
+ * range_decompressor.cpp
+ * 		Definiciones de la clase arithmetic::range_decompressor
+******************************************************************************/
+#include "range_decompressor.h"
+#include "../commons/assertions/assertions.h"
+#include "../commons/log/log.h"
+
+using namespace arithmetic;
+
+range_decompressor::range_decompressor(commons::io::binary_source &source)
+: binary_source(source), code(0), range(0xFFFFFFFFu) {
+	for (int i = 0; i < ARITHMETIC_RANGE_CODER_FLUSH_BYTES; i++) {
+		code = (code << 8) | get_byte_from_source();
+	}
+}
+
+symbol range_decompressor::decompress(const symbol_distribution &distribution) {
+	uint32_t frequency = decode_frequency(distribution.get_total_frequency());
+	symbol s = distribution.get_symbol_for_frequency(frequency);
+	decode(distribution.get_accumulated_frequency(s), distribution.get_emissions(s));
+
+	LOG_DEBUG_VAR(s);
+	return s;
+}
+
+symbol range_decompressor::decompress(const symbol_distribution::excluded_view &distribution) {
+	uint32_t frequency = decode_frequency(distribution.get_total_frequency());
+	symbol s = distribution.get_symbol_for_frequency(frequency);
+	decode(distribution.get_accumulated_frequency(s), distribution.get_emissions(s));
+
+	LOG_DEBUG_VAR(s);
+	return s;
+}
+
+uint32_t range_decompressor::decode_frequency(uint32_t total) {
+	ASSERTION(total < ARITHMETIC_RANGE_CODER_MAX_TOTAL);
+
+	// Busco en que subintervalo cae el código actual
+	range /= total;
+	uint32_t frequency = code / range;
+	if (frequency >= total) {
+		frequency = total - 1;
+	}
+	return frequency;
+}
+
+void range_decompressor::decode(uint32_t start, uint32_t size) {
+	// Achico el intervalo igual que lo hizo el compresor
+	code -= start * range;
+	range *= size;
+
+	// Normalizo de a un byte por vez
+	while (range < ARITHMETIC_RANGE_CODER_TOP) {
+		code = (code << 8) | get_byte_from_source();
+		range <<= 8;
+	}
+}
+
+unsigned char range_decompressor::get_byte_from_source() {
+	// El compresor no emite el último byte de la cola, así que
+	// si el origen se termina completamos con ceros
+	return static_cast<unsigned char>(binary_source.read_bits(8).second);
+}
@@ -0,0 +1,54 @@
+/******************************************************************************
+ * range_decompressor.h
+ * 		Declaraciones de la clase arithmetic::range_decompressor
+******************************************************************************/
+#ifndef __ARITHMETIC_RANGE_DECOMPRESSOR_H_INCLUDED__
+#define __ARITHMETIC_RANGE_DECOMPRESSOR_H_INCLUDED__
+
+#include "../commons/io/binary_source.h"
+#include "symbol_distribution.h"
+#include "range_coder.h"
+#include <stdint.h>
+
+namespace arithmetic {
+
+/**
+ * Decompresor aritmético por rangos, contraparte de
+ * arithmetic::range_compressor.
+ */
+class range_decompressor {
+private:
+	commons::io::binary_source &binary_source;
+
+	uint32_t code;
+
+	uint32_t range;
+
+	unsigned char get_byte_from_source();
+
+	uint32_t decode_frequency(uint32_t total);
+
+	void decode(uint32_t start, uint32_t size);
+public:
+	/**
+	 * Crea una nueva instancia de range_decompressor que tomará
+	 * bits desde el binary_source dado.
+	 */
+	range_decompressor(commons::io::binary_source &source);
+
+	/**
+	 * Descomprime el siguiente símbolo desde el binary_source
+	 * usando la distribución de probabilidades dada.
+	 */
+	symbol decompress(const symbol_distribution &distribution);
+
+	/**
+	 * Descomprime el siguiente símbolo desde el binary_source
+	 * usando una vista con exclusiones de una distribución.
+	 */
+	symbol decompress(const symbol_distribution::excluded_view &distribution);
+};
+
+};
+
+#endif
@@ -4,64 +4,173 @@
 ******************************************************************************/
 #include "symbol_distribution.h"
 #include "../commons/io/serializators.h"
+#include "../commons/assertions/assertions.h"
+#include <cstring>
 
 using namespace arithmetic;
 
-symbol_distribution::symbol_distribution(bool default_esc)
-: total_frequencies(0) {
-	for (int i = 0; i < ARITHMETIC_SYMBOL_COUNT; i++) {
-		frequencies[i] = 0u;
+namespace {
+
+// Mayor potencia de dos que no supera la cantidad de símbolos,
+// utilizada para descender por el árbol de frecuencias acumuladas
+const unsigned int tree_top_step = 256u;
+
+#if ARITHMETIC_DISTRIBUTION_RESCALE_LIMIT >= 65535
+#error "ARITHMETIC_DISTRIBUTION_RESCALE_LIMIT no entra en contadores de 16 bits"
+#endif
+
+// Enteros de largo variable: 7 bits por byte, empezando por los
+// menos significativos, con el bit alto encendido en todos los
+// bytes salvo el último
+int varint_length(unsigned int value) {
+	int length = 1;
+	while (value >= 0x80u) {
+		value >>= 7;
+		length++;
 	}
+	return length;
+}
+
+int write_varint(unsigned int value, commons::io::block *b, int index) {
+	char *data = b->raw_char_pointer() + index;
+	int length = 0;
+	while (value >= 0x80u) {
+		data[length++] = static_cast<char>((value & 0x7Fu) | 0x80u);
+		value >>= 7;
+	}
+	data[length++] = static_cast<char>(value);
+	return length;
+}
+
+int read_varint(const commons::io::block &b, int index, unsigned int &value) {
+	const unsigned char *data = reinterpret_cast<const unsigned char *>(b.raw_char_pointer() + index);
+	int length = 0;
+	int shift = 0;
+	value = 0;
+	while (data[length] & 0x80u) {
+		value |= static_cast<unsigned int>(data[length++] & 0x7Fu) << shift;
+		shift += 7;
+	}
+	value |= static_cast<unsigned int>(data[length++]) << shift;
+	return length;
+}
+
+};
+
+symbol_distribution::symbol_distribution(bool default_esc)
+: dense(0) {
+	clear_frequencies();
 
 	if (default_esc) {
-		frequencies[symbol::ESC.get_sequential_code()] = 1u;
-		total_frequencies = 1;
+		add_frequency(symbol::ESC.get_sequential_code(), 1u);
 	}
 }
 
 symbol_distribution::symbol_distribution(const symbol &s)
-: total_frequencies(1) {
-	for (int i = 0; i < ARITHMETIC_SYMBOL_COUNT; i++) {
-		frequencies[i] = 0u;
+: dense(0) {
+	clear_frequencies();
+	add_frequency(s.get_sequential_code(), 1u);
+}
+
+symbol_distribution::symbol_distribution(const symbol_distribution &other)
+: dense(0) {
+	*this = other;
+}
+
+symbol_distribution &symbol_distribution::operator=(const symbol_distribution &other) {
+	if (this == &other)
+		return *this;
+
+	total_frequencies = other.total_frequencies;
+	if (other.dense) {
+		// Reutilizo los contadores si ya los tenía alocados
+		if (!dense)
+			dense = new dense_frequencies;
+		*dense = *other.dense;
+		sparse_count = 0;
+	} else {
+		delete dense;
+		dense = 0;
+		sparse_count = other.sparse_count;
+		std::memcpy(sparse_codes, other.sparse_codes, sparse_count * sizeof(sparse_codes[0]));
+		std::memcpy(sparse_frequencies, other.sparse_frequencies, sparse_count * sizeof(sparse_frequencies[0]));
 	}
-	frequencies[s.get_sequential_code()] = 1u;
+	return *this;
+}
+
+symbol_distribution::~symbol_distribution() {
+	delete dense;
 }
 
 void symbol_distribution::register_symbol_emision(const symbol &s) {
-	frequencies[s.get_sequential_code()]++;
-	total_frequencies++;
+	add_frequency(s.get_sequential_code(), 1u);
+	if (total_frequencies > ARITHMETIC_DISTRIBUTION_RESCALE_LIMIT)
+		rescale();
 }
 
 bool symbol_distribution::has_symbol(const symbol &s) const {
-	return 0 != frequencies[s.get_sequential_code()];
+	return 0 != frequency_of(s.get_sequential_code());
 }
 
 double symbol_distribution::get_accumulated_probability(const symbol &s) const {
-	double result = 0.0;
-	for (unsigned int i = 0; i < s.get_sequential_code(); i++) {
-		result +=
-				static_cast<double>(frequencies[i]) /
-				static_cast<double>(total_frequencies);
-	}
-	return result;
+	return
+		static_cast<double>(get_accumulated_frequency(s)) /
+		static_cast<double>(total_frequencies);
 }
 
 double symbol_distribution::get_probability_of(const symbol &s) const {
-	int index = s.get_sequential_code();
 	return
-		static_cast<double>(frequencies[index]) /
+		static_cast<double>(frequency_of(s.get_sequential_code())) /
 		static_cast<double>(total_frequencies);
 }
 
+unsigned int symbol_distribution::get_accumulated_frequency(const symbol &s) const {
+	return prefix_frequency(s.get_sequential_code());
+}
+
+unsigned int symbol_distribution::get_total_frequency() const {
+	return total_frequencies;
+}
+
+unsigned int symbol_distribution::heap_size() const {
+	return dense != NULL ? sizeof(dense_frequencies) : 0;
+}
+
+symbol symbol_distribution::get_symbol_for_frequency(unsigned int frequency) const {
+	ASSERTION_WITH_MESSAGE(frequency < total_frequencies, "La frecuencia pedida excede la frecuencia total de la distribución");
+
+	if (!dense) {
+		// Con pocos símbolos alcanza con recorrerlos en orden
+		unsigned int i = 0;
+		while (sparse_frequencies[i] <= frequency) {
+			frequency -= sparse_frequencies[i];
+			i++;
+		}
+		return symbol(sparse_codes[i]);
+	}
+
+	// Desciendo por el árbol buscando la mayor cantidad de símbolos
+	// cuya frecuencia acumulada no supera a frequency
+	unsigned int position = 0;
+	for (unsigned int step = tree_top_step; step > 0; step >>= 1) {
+		unsigned int next = position + step;
+		if (next <= ARITHMETIC_SYMBOL_COUNT && dense->cumulative_tree[next] <= frequency) {
+			position = next;
+			frequency -= dense->cumulative_tree[next];
+		}
+	}
+	return symbol(position);
+}
+
 bool symbol_distribution::has_only_the_symbol(const symbol &s) const {
-	return frequencies[s.get_sequential_code()] == 1 && total_frequencies == 1;
+	return total_frequencies == 1 && frequency_of(s.get_sequential_code()) == 1;
 }
 
 unsigned int symbol_distribution::get_emissions(const symbol &s) const {
-	return frequencies[s.get_sequential_code()];
+	return frequency_of(s.get_sequential_code());
 }
 
-void symbol_distribution::append_to_exclusion_set(std::set<symbol> &exclusion) const {
+void symbol_distribution::append_to_exclusion_set(exclusion_set &exclusion) const {
 	for (iterator it = begin(); it != end(); it++) {
 		symbol current_symbol = *it;
 		if (current_symbol != symbol::ESC)
@@ -69,28 +178,282 @@ void symbol_distribution::append_to_exclusion_set(std::set<symbol> &exclusion) c
 	}
 }
 
-symbol_distribution symbol_distribution::exclude(const std::set<symbol> &exclusion) const {
-	symbol_distribution copy = *this;
+symbol_distribution::excluded_view symbol_distribution::exclude(const exclusion_set &exclusion) const {
+	return excluded_view(*this, exclusion);
+}
 
-	typedef std::set<symbol>::const_iterator iterator;
-	for (iterator it = exclusion.begin(); it != exclusion.end(); it++) {
-		symbol current_symbol = *it;
+void symbol_distribution::clear_frequencies() {
+	delete dense;
+	dense = 0;
+	sparse_count = 0;
+	total_frequencies = 0;
+}
 
-		copy.total_frequencies -= copy.frequencies[current_symbol.get_sequential_code()];
-		copy.frequencies[current_symbol.get_sequential_code()] = 0;
+void symbol_distribution::add_frequency(unsigned int code, unsigned int amount) {
+	total_frequencies += amount;
+	if (dense) {
+		add_dense_frequency(code, amount);
+		return;
+	}
+
+	unsigned int position = sparse_position(code);
+	if (position < sparse_count && sparse_codes[position] == code) {
+		sparse_frequencies[position] += amount;
+	} else if (sparse_count < ARITHMETIC_SPARSE_DISTRIBUTION_LIMIT) {
+		// Hago lugar para el símbolo nuevo manteniendo el orden
+		unsigned int moved = sparse_count - position;
+		std::memmove(sparse_codes + position + 1, sparse_codes + position, moved * sizeof(sparse_codes[0]));
+		std::memmove(sparse_frequencies + position + 1, sparse_frequencies + position, moved * sizeof(sparse_frequencies[0]));
+		sparse_codes[position] = code;
+		sparse_frequencies[position] = amount;
+		sparse_count++;
+	} else {
+		promote_to_dense();
+		add_dense_frequency(code, amount);
+	}
+}
+
+void symbol_distribution::add_dense_frequency(unsigned int code, unsigned int amount) {
+	dense->frequencies[code] += amount;
+	for (unsigned int i = code + 1; i <= ARITHMETIC_SYMBOL_COUNT; i += i & (~i + 1)) {
+		dense->cumulative_tree[i] += amount;
 	}
-	return copy;
 }
 
-symbol_distribution::iterator::iterator(unsigned int current_position, const unsigned int *frequencies)
-: current_position(current_position), frequencies(frequencies) {
-	if (current_position < ARITHMETIC_SYMBOL_COUNT && frequencies[current_position] == 0) {
+void symbol_distribution::promote_to_dense() {
+	dense = new dense_frequencies;
+	std::memset(dense, 0, sizeof(dense_frequencies));
+	for (unsigned int i = 0; i < sparse_count; i++) {
+		add_dense_frequency(sparse_codes[i], sparse_frequencies[i]);
+	}
+	sparse_count = 0;
+}
+
+void symbol_distribution::rescale() {
+	// Redondeo para arriba para que ningún símbolo quede sin frecuencia
+	total_frequencies = 0;
+	if (!dense) {
+		for (unsigned int i = 0; i < sparse_count; i++) {
+			sparse_frequencies[i] = (sparse_frequencies[i] + 1) / 2;
+			total_frequencies += sparse_frequencies[i];
+		}
+		return;
+	}
+
+	// Reconstruyo el árbol en O(n): cada nodo suma su frecuencia
+	// y se la pasa a su padre
+	for (unsigned int i = 0; i < ARITHMETIC_SYMBOL_COUNT; i++) {
+		dense->frequencies[i] = (dense->frequencies[i] + 1) / 2;
+		total_frequencies += dense->frequencies[i];
+		dense->cumulative_tree[i + 1] = dense->frequencies[i];
+	}
+	for (unsigned int i = 1; i <= ARITHMETIC_SYMBOL_COUNT; i++) {
+		unsigned int parent = i + (i & (~i + 1));
+		if (parent <= ARITHMETIC_SYMBOL_COUNT)
+			dense->cumulative_tree[parent] += dense->cumulative_tree[i];
+	}
+}
+
+unsigned int symbol_distribution::sparse_position(unsigned int code) const {
+	// Posición del primer símbolo con código mayor o igual a code
+	unsigned int position = 0;
+	while (position < sparse_count && sparse_codes[position] < code)
+		position++;
+	return position;
+}
+
+unsigned int symbol_distribution::frequency_of(unsigned int code) const {
+	if (dense)
+		return dense->frequencies[code];
+
+	unsigned int position = sparse_position(code);
+	if (position < sparse_count && sparse_codes[position] == code)
+		return sparse_frequencies[position];
+	return 0;
+}
+
+unsigned int symbol_distribution::prefix_frequency(unsigned int count) const {
+	unsigned int result = 0;
+	if (!dense) {
+		for (unsigned int i = 0; i < sparse_count && sparse_codes[i] < count; i++) {
+			result += sparse_frequencies[i];
+		}
+		return result;
+	}
+
+	for (unsigned int i = count; i > 0; i -= i & (~i + 1)) {
+		result += dense->cumulative_tree[i];
+	}
+	return result;
+}
+
+unsigned int symbol_distribution::distinct_symbols() const {
+	if (!dense)
+		return sparse_count;
+
+	unsigned int result = 0;
+	for (unsigned int i = 0; i < ARITHMETIC_SYMBOL_COUNT; i++) {
+		result += (dense->frequencies[i] > 0 ? 1 : 0);
+	}
+	return result;
+}
+
+symbol_distribution::exclusion_set::exclusion_set() {
+	clear();
+}
+
+void symbol_distribution::exclusion_set::insert(const symbol &s) {
+	unsigned int code = s.get_sequential_code();
+	bits[code / 32] |= 1u << (code % 32);
+}
+
+bool symbol_distribution::exclusion_set::contains(const symbol &s) const {
+	unsigned int code = s.get_sequential_code();
+	return 0 != (bits[code / 32] & (1u << (code % 32)));
+}
+
+unsigned int symbol_distribution::exclusion_set::size() const {
+	unsigned int result = 0;
+	for (unsigned int i = 0; i < sizeof(bits) / sizeof(bits[0]); i++) {
+		result += __builtin_popcount(bits[i]);
+	}
+	return result;
+}
+
+void symbol_distribution::exclusion_set::clear() {
+	for (unsigned int i = 0; i < sizeof(bits) / sizeof(bits[0]); i++) {
+		bits[i] = 0u;
+	}
+}
+
+symbol_distribution::excluded_view::excluded_view(const symbol_distribution &distribution, const exclusion_set &exclusion)
+: distribution(&distribution), excluded_count(0) {
+	excluded_accumulated[0] = 0u;
+
+	// En la representación compacta recorro los símbolos de la
+	// distribución, que ya están en orden creciente de código
+	if (!distribution.dense) {
+		for (unsigned int i = 0; i < distribution.sparse_count; i++) {
+			if (exclusion.contains(symbol(distribution.sparse_codes[i]))) {
+				excluded_codes[excluded_count] = distribution.sparse_codes[i];
+				excluded_accumulated[excluded_count + 1] = excluded_accumulated[excluded_count] + distribution.sparse_frequencies[i];
+				excluded_count++;
+			}
+		}
+		return;
+	}
+
+	// Recorro sólo los bits encendidos del set, en orden creciente
+	// de código, guardando los excluidos que tienen frecuencia
+	for (unsigned int i = 0; i < sizeof(exclusion.bits) / sizeof(exclusion.bits[0]); i++) {
+		unsigned int word = exclusion.bits[i];
+		while (word != 0) {
+			unsigned int code = i * 32 + __builtin_ctz(word);
+			word &= word - 1;
+
+			unsigned int frequency = distribution.dense->frequencies[code];
+			if (frequency > 0) {
+				excluded_codes[excluded_count] = code;
+				excluded_accumulated[excluded_count + 1] = excluded_accumulated[excluded_count] + frequency;
+				excluded_count++;
+			}
+		}
+	}
+}
+
+unsigned int symbol_distribution::excluded_view::excluded_frequency_before(unsigned int code) const {
+	// Búsqueda binaria de la cantidad de excluidos con código menor a code
+	unsigned int lower = 0;
+	unsigned int upper = excluded_count;
+	while (lower < upper) {
+		unsigned int middle = (lower + upper) / 2;
+		if (excluded_codes[middle] < code) {
+			lower = middle + 1;
+		} else {
+			upper = middle;
+		}
+	}
+	return excluded_accumulated[lower];
+}
+
+bool symbol_distribution::excluded_view::has_symbol(const symbol &s) const {
+	return 0 != get_emissions(s);
+}
+
+unsigned int symbol_distribution::excluded_view::get_emissions(const symbol &s) const {
+	unsigned int code = s.get_sequential_code();
+	if (excluded_frequency_before(code + 1) != excluded_frequency_before(code)) {
+		return 0;
+	}
+	return distribution->frequency_of(code);
+}
+
+double symbol_distribution::excluded_view::get_probability_of(const symbol &s) const {
+	return
+		static_cast<double>(get_emissions(s)) /
+		static_cast<double>(get_total_frequency());
+}
+
+unsigned int symbol_distribution::excluded_view::get_accumulated_frequency(const symbol &s) const {
+	unsigned int code = s.get_sequential_code();
+	return distribution->prefix_frequency(code) - excluded_frequency_before(code);
+}
+
+unsigned int symbol_distribution::excluded_view::get_total_frequency() const {
+	return distribution->total_frequencies - excluded_accumulated[excluded_count];
+}
+
+symbol symbol_distribution::excluded_view::get_symbol_for_frequency(unsigned int frequency) const {
+	ASSERTION_WITH_MESSAGE(frequency < get_total_frequency(), "La frecuencia pedida excede la frecuencia total de la vista");
+
+	if (!distribution->dense) {
+		// Recorro los símbolos en orden, salteando los excluidos,
+		// que también están ordenados por código
+		unsigned int excluded = 0;
+		unsigned int i = 0;
+		while (true) {
+			unsigned int code = distribution->sparse_codes[i];
+			while (excluded < excluded_count && excluded_codes[excluded] < code)
+				excluded++;
+
+			if (excluded == excluded_count || excluded_codes[excluded] != code) {
+				if (distribution->sparse_frequencies[i] > frequency)
+					return symbol(code);
+				frequency -= distribution->sparse_frequencies[i];
+			}
+			i++;
+		}
+	}
+
+	// Mismo descenso que en la distribución, pero comparando contra
+	// la frecuencia acumulada menos la de los excluidos, que también
+	// es monótona en la cantidad de símbolos
+	unsigned int position = 0;
+	unsigned int accumulated = 0;
+	for (unsigned int step = tree_top_step; step > 0; step >>= 1) {
+		unsigned int next = position + step;
+		if (next <= ARITHMETIC_SYMBOL_COUNT) {
+			unsigned int candidate = accumulated + distribution->dense->cumulative_tree[next];
+			if (candidate - excluded_frequency_before(next) <= frequency) {
+				position = next;
+				accumulated = candidate;
+			}
+		}
+	}
+	return symbol(position);
+}
+
+symbol_distribution::iterator::iterator(const symbol_distribution *distribution, unsigned int current_position)
+: distribution(distribution), current_position(current_position) {
+	if (distribution->dense && current_position < ARITHMETIC_SYMBOL_COUNT && distribution->dense->frequencies[current_position] == 0) {
 		this->operator++(0);
 	}
 }
 
 symbol symbol_distribution::iterator::operator*() const {
-	return symbol(current_position);
+	if (distribution->dense)
+		return symbol(current_position);
+	return symbol(distribution->sparse_codes[current_position]);
 }
 
 bool symbol_distribution::iterator::operator==(const iterator &other) const {
@@ -102,17 +465,24 @@ bool symbol_distribution::iterator::operator!=(const iterator &other) const {
 }
 
 void symbol_distribution::iterator::operator++(int) {
+	// En la representación compacta todas las posiciones tienen
+	// un símbolo; en la otra salteo los que no tienen frecuencia
+	if (!distribution->dense) {
+		current_position++;
+		return;
+	}
+
 	do {
 		current_position++;
-	} while (current_position < ARITHMETIC_SYMBOL_COUNT && frequencies[current_position] == 0);
+	} while (current_position < ARITHMETIC_SYMBOL_COUNT && distribution->dense->frequencies[current_position] == 0);
 }
 
 symbol_distribution::iterator symbol_distribution::begin() const {
-	return iterator(0, frequencies);
+	return iterator(this, 0);
 }
 
 symbol_distribution::iterator symbol_distribution::end() const {
-	return iterator(ARITHMETIC_SYMBOL_COUNT, frequencies);
+	return iterator(this, dense ? ARITHMETIC_SYMBOL_COUNT : sparse_count);
 }
 
 std::ostream &arithmetic::operator<<(std::ostream &output, const symbol_distribution &distribution) {
@@ -124,54 +494,55 @@ std::ostream &arithmetic::operator<<(std::ostream &output, const symbol_distribu
 	return output;
 }
 
+unsigned int arithmetic::heap_size_of(const symbol_distribution &distribution) {
+	return distribution.heap_size();
+}
+
 // Los serializadores de symbol distribution funcionan con el siguiente esquema de serialización:
-// cantidad_de_simbolos_distintos | simbolo_n | frequencia_de_simbolo_n | simbolo_n+1 | frequencia_de_simbolo_n+1 | ...
+// cantidad_de_simbolos_distintos | delta_de_codigo_n | frequencia_de_simbolo_n | delta_de_codigo_n+1 | ...
+// Todos los campos son enteros de largo variable. Los símbolos van en orden creciente de código y
+// se guarda la diferencia con el código anterior, así que casi todos los campos ocupan un byte.
 
 template<>
 int commons::io::serialization_length<symbol_distribution>(const symbol_distribution &instance) {
-	unsigned short distinct_symbols = 0;
-	for (unsigned short i = 0; i < ARITHMETIC_SYMBOL_COUNT; i++) {
-		distinct_symbols += (instance.frequencies[i] > 0 ? 1 : 0);
+	int length = varint_length(instance.distinct_symbols());
+
+	unsigned int previous_code = 0;
+	for (symbol_distribution::iterator it = instance.begin(); it != instance.end(); it++) {
+		unsigned int code = (*it).get_sequential_code();
+		length += varint_length(code - previous_code);
+		length += varint_length(instance.frequency_of(code));
+		previous_code = code;
 	}
-
-	return
-		sizeof(unsigned short)  + 						// 1 unsigned short para la cantidad de simbolos distintos
-		distinct_symbols * sizeof(unsigned short) + 	// N unsigned shorts para el código de símbolo
-		distinct_symbols * sizeof(unsigned int);		// N unsigned ints para las frequencias
+	return length;
 }
 
 template<>
 int commons::io::serialization_length<symbol_distribution>(const commons::io::block &b, int index) {
-	// Levantamos la cantidad de símbolos
-	unsigned short distinct_symbols = commons::io::deserialize<unsigned short>(b, index);
+	unsigned int distinct_symbols;
+	int current_field_position = index;
+	current_field_position += read_varint(b, current_field_position, distinct_symbols);
 
-	return
-		sizeof(unsigned short)  + 						// 1 unsigned short para la cantidad de simbolos distintos
-		distinct_symbols * sizeof(unsigned short) + 	// N unsigned shorts para el código de símbolo
-		distinct_symbols * sizeof(unsigned int);		// N unsigned ints para las frequencias
+	// Salteo los pares código, frecuencia
+	unsigned int field;
+	for (unsigned int i = 0; i < 2 * distinct_symbols; i++) {
+		current_field_position += read_varint(b, current_field_position, field);
+	}
+	return current_field_position - index;
 }
 
 template<>
 void commons::io::serialize<symbol_distribution>(const symbol_distribution &instance, commons::io::block *b, int index) {
-	unsigned short distinct_symbols = 0;
-	for (unsigned short i = 0; i < ARITHMETIC_SYMBOL_COUNT; i++) {
-		distinct_symbols += (instance.frequencies[i] > 0 ? 1 : 0);
-	}
-
-	// Serializamos la cantidad de símbolos
 	int current_field_position = index;
-	commons::io::serialize(distinct_symbols, b, current_field_position);
-	current_field_position += commons::io::serialization_length(distinct_symbols);
+	current_field_position += write_varint(instance.distinct_symbols(), b, current_field_position);
 
 	// Por cada símbolo que tenga frequencia
-	for (unsigned short i = 0; i < ARITHMETIC_SYMBOL_COUNT; i++) {
-		if (instance.frequencies[i] > 0) {
-			commons::io::serialize(i, b, current_field_position);
-			current_field_position += commons::io::serialization_length(i);
-
-			commons::io::serialize(instance.frequencies[i], b, current_field_position);
-			current_field_position += commons::io::serialization_length(instance.frequencies[i]);
-		}
+	unsigned int previous_code = 0;
+	for (symbol_distribution::iterator it = instance.begin(); it != instance.end(); it++) {
+		unsigned int code = (*it).get_sequential_code();
+		current_field_position += write_varint(code - previous_code, b, current_field_position);
+		current_field_position += write_varint(instance.frequency_of(code), b, current_field_position);
+		previous_code = code;
 	}
 }
 
@@ -181,18 +552,19 @@ symbol_distribution commons::io::deserialize<symbol_distribution>(const commons:
 
 	int current_field_position = index;
 	// Levantamos la cantidad de símbolos
-	unsigned short distinct_symbols = commons::io::deserialize<unsigned short>(b, current_field_position);
-	current_field_position += commons::io::serialization_length(distinct_symbols);
+	unsigned int distinct_symbols;
+	current_field_position += read_varint(b, current_field_position, distinct_symbols);
 
-	for (unsigned short i = 0; i < distinct_symbols; i++) {
-		unsigned short symbol_sequential_code = commons::io::deserialize<unsigned short>(b, current_field_position);
-		current_field_position += commons::io::serialization_length(symbol_sequential_code);
+	unsigned int code = 0;
+	for (unsigned int i = 0; i < distinct_symbols; i++) {
+		unsigned int delta;
+		current_field_position += read_varint(b, current_field_position, delta);
+		code += delta;
 
-		unsigned int frequency = commons::io::deserialize<unsigned int>(b, current_field_position);
-		current_field_position += commons::io::serialization_length(frequency);
+		unsigned int frequency;
+		current_field_position += read_varint(b, current_field_position, frequency);
 
-		result.frequencies[symbol_sequential_code] = frequency;
-		result.total_frequencies += frequency;
+		result.add_frequency(code, frequency);
 	}
 
 	return result;
@@ -6,20 +6,57 @@
 #define __ARITHMETIC_SYMBOL_DISTRIBUTION_H_INCLUDED__
 
 #include "symbol.h"
+#include "../config/config.h"
 #include "../commons/io/block.h"
 #include "../commons/io/serializators.h"
-#include <set>
 
 
 namespace arithmetic {
 
 /**
- * Representa una distribución de probabilidades de símbolos
+ * Representa una distribución de probabilidades de símbolos.
+ *
+ * Mientras tiene pocos símbolos distintos (el caso típico de
+ * los contextos de orden alto) guarda sólo los pares símbolo,
+ * frecuencia dentro de la misma instancia; al superar ese límite
+ * pasa a un contador por símbolo alocado aparte.
  */
 class symbol_distribution {
 private:
-	unsigned int frequencies[ARITHMETIC_SYMBOL_COUNT];
+	/**
+	 * Representación con un contador por símbolo, que se usa
+	 * una vez que la distribución supera los
+	 * ARITHMETIC_SPARSE_DISTRIBUTION_LIMIT símbolos distintos.
+	 * Como el total nunca supera ARITHMETIC_DISTRIBUTION_RESCALE_LIMIT
+	 * alcanza con contadores de 16 bits.
+	 */
+	struct dense_frequencies {
+		unsigned short frequencies[ARITHMETIC_SYMBOL_COUNT];
+
+		// Árbol de Fenwick (indexado desde 1) sobre frequencies, que
+		// permite obtener frecuencias acumuladas en O(log n)
+		unsigned short cumulative_tree[ARITHMETIC_SYMBOL_COUNT + 1];
+	};
+
 	unsigned int total_frequencies;
+
+	// Representación compacta: los símbolos con frecuencia,
+	// ordenados por código. Sólo es válida si dense es nulo
+	unsigned int sparse_count;
+	unsigned short sparse_codes[ARITHMETIC_SPARSE_DISTRIBUTION_LIMIT];
+	unsigned short sparse_frequencies[ARITHMETIC_SPARSE_DISTRIBUTION_LIMIT];
+
+	dense_frequencies *dense;
+
+	void clear_frequencies();
+	void add_frequency(unsigned int code, unsigned int amount);
+	void add_dense_frequency(unsigned int code, unsigned int amount);
+	void promote_to_dense();
+	void rescale();
+	unsigned int sparse_position(unsigned int code) const;
+	unsigned int frequency_of(unsigned int code) const;
+	unsigned int prefix_frequency(unsigned int count) const;
+	unsigned int distinct_symbols() const;
 public:
 	/**
 	 * Crea una nueva instancia de symbol_distribution
@@ -34,7 +71,22 @@ public:
 	symbol_distribution(const symbol &s);
 
 	/**
-	 * Registra la emisión de un símbolo dado
+	 * Crea una copia de una distribución dada
+	 */
+	symbol_distribution(const symbol_distribution &other);
+
+	/**
+	 * Copia una distribución dada sobre esta
+	 */
+	symbol_distribution &operator=(const symbol_distribution &other);
+
+	~symbol_distribution();
+
+	/**
+	 * Registra la emisión de un símbolo dado. Si con esta emisión
+	 * la frecuencia total supera ARITHMETIC_DISTRIBUTION_RESCALE_LIMIT,
+	 * divide a la mitad la frecuencia de todos los símbolos, sin
+	 * quitar ninguno de la distribución.
 	 */
 	void register_symbol_emision(const symbol &s);
 
@@ -56,6 +108,33 @@ public:
 	 */
 	double get_probability_of(const symbol &s) const;
 
+	/**
+	 * Determina la frecuencia acumulada de todos los
+	 * símbolos anteriores a un símbolo dado.
+	 */
+	unsigned int get_accumulated_frequency(const symbol &s) const;
+
+	/**
+	 * Devuelve la suma de las frecuencias de todos los
+	 * símbolos de la distribución.
+	 */
+	unsigned int get_total_frequency() const;
+
+	/**
+	 * Devuelve la cantidad de bytes que la distribución aloca
+	 * aparte de la instancia (el contador por símbolo, una vez
+	 * que deja la representación compacta).
+	 */
+	unsigned int heap_size() const;
+
+	/**
+	 * Devuelve el símbolo cuyo intervalo de frecuencias
+	 * acumuladas [acumulada, acumulada + emisiones) contiene
+	 * a frequency. frequency DEBE ser menor a la frecuencia
+	 * total de la distribución.
+	 */
+	symbol get_symbol_for_frequency(unsigned int frequency) const;
+
 	/**
 	 * Devuelve true si sólamente hay un símbolo en la distribución
 	 */
@@ -66,24 +145,120 @@ public:
 	 */
 	unsigned int get_emissions(const symbol &s) const;
 
+	class excluded_view;
+
 	/**
-	 * Tipo que representa un set de exclusión
+	 * Representa un set de exclusión como un mapa de bits de
+	 * tamaño fijo, con un bit por cada símbolo posible
 	 */
-	typedef std::set<symbol> exclusion_set;
+	class exclusion_set {
+	private:
+		unsigned int bits[(ARITHMETIC_SYMBOL_COUNT + 31) / 32];
+
+		friend class excluded_view;
+	public:
+		/**
+		 * Crea un nuevo set de exclusión vacío
+		 */
+		exclusion_set();
+
+		/**
+		 * Agrega un símbolo al set de exclusión
+		 */
+		void insert(const symbol &s);
+
+		/**
+		 * Determina si un símbolo está en el set de exclusión
+		 */
+		bool contains(const symbol &s) const;
+
+		/**
+		 * Devuelve la cantidad de símbolos en el set
+		 */
+		unsigned int size() const;
+
+		/**
+		 * Quita todos los símbolos del set
+		 */
+		void clear();
+	};
 
 	/**
-	 * Devuelve un set que contiene todos los chars que
-	 * contiene esta distribución, sin incluir el ESC ni
-	 * el EOF
+	 * Agrega al set de exclusión todos los símbolos que
+	 * contiene esta distribución, sin incluir el ESC
 	 */
 	void append_to_exclusion_set(exclusion_set &exclusion) const;
 
 	/**
-	 * Crea una distribución copia de esta que toma todos los
-	 * de esta menos aquellos que están incluidos en el set de
-	 * exclusion dado.
+	 * Representa una vista de solo lectura sobre una distribución
+	 * que se comporta como si los símbolos de un set de exclusión
+	 * no hubiesen sido emitidos nunca. No copia la distribución:
+	 * sólo guarda las frecuencias de los símbolos excluidos que
+	 * la distribución efectivamente contiene. La distribución
+	 * DEBE sobrevivir a la vista.
 	 */
-	symbol_distribution exclude(const exclusion_set &exclusion) const;
+	class excluded_view {
+	private:
+		const symbol_distribution *distribution;
+		unsigned int excluded_count;
+		unsigned short excluded_codes[ARITHMETIC_SYMBOL_COUNT];
+
+		// excluded_accumulated[i] es la suma de las frecuencias
+		// de los primeros i símbolos excluidos
+		unsigned int excluded_accumulated[ARITHMETIC_SYMBOL_COUNT + 1];
+
+		unsigned int excluded_frequency_before(unsigned int code) const;
+	public:
+		/**
+		 * Crea una vista de distribution sin los símbolos de
+		 * exclusion
+		 */
+		excluded_view(const symbol_distribution &distribution, const exclusion_set &exclusion);
+
+		/**
+		 * Determina si existe un símbolo no excluido en la vista
+		 */
+		bool has_symbol(const symbol &s) const;
+
+		/**
+		 * Devuelve la cantidad de veces que un símbolo fue
+		 * emitido, o 0 si está excluido
+		 */
+		unsigned int get_emissions(const symbol &s) const;
+
+		/**
+		 * Determina la probabilidad que de un símbolo dado
+		 * ocurra, sin contar los símbolos excluidos.
+		 */
+		double get_probability_of(const symbol &s) const;
+
+		/**
+		 * Determina la frecuencia acumulada de todos los
+		 * símbolos no excluidos anteriores a un símbolo dado.
+		 */
+		unsigned int get_accumulated_frequency(const symbol &s) const;
+
+		/**
+		 * Devuelve la suma de las frecuencias de todos los
+		 * símbolos no excluidos.
+		 */
+		unsigned int get_total_frequency() const;
+
+		/**
+		 * Devuelve el símbolo no excluido cuyo intervalo de
+		 * frecuencias acumuladas contiene a frequency. frequency
+		 * DEBE ser menor a la frecuencia total de la vista.
+		 */
+		symbol get_symbol_for_frequency(unsigned int frequency) const;
+	};
+
+	friend class excluded_view;
+
+	/**
+	 * Devuelve una vista de esta distribución que no tiene en
+	 * cuenta los símbolos incluidos en el set de exclusión dado.
+	 */
+	excluded_view exclude(const exclusion_set &exclusion) const;
 
 	/**
 	 * Representa un iterador para recorrer los símbolos
@@ -91,14 +266,17 @@ public:
 	 */
 	class iterator {
 	private:
+		const symbol_distribution *distribution;
 		unsigned int current_position;
-		const unsigned int *frequencies;
 	public:
 		/**
 		 * Crea un nuevo iterator apuntando a la posición
-		 * current_position de frequencies.
+		 * current_position de la representación de distribution:
+		 * el índice del símbolo en la representación compacta,
+		 * o su código en la representación con un contador por
+		 * símbolo.
 		 */
-		iterator(unsigned int current_position, const unsigned int *frequencies);
+		iterator(const symbol_distribution *distribution, unsigned int current_position);
 
 		/**
 		 * Devuelve el símbolo actual
@@ -123,6 +301,8 @@ public:
 		void operator++(int);
 	};
 
+	friend class iterator;
+
 	/**
 	 * Devuelve un iterador apuntando al primer símbolo
 	 */
@@ -145,6 +325,12 @@ public:
 
 std::ostream &operator<<(std::ostream &output, const symbol_distribution &symbol);
 
+/**
+ * Memoria alocada aparte por una distribución, para los
+ * contenedores que acotan su consumo (ver trie::heap_size_of)
+ */
+unsigned int heap_size_of(const symbol_distribution &distribution);
+
 };
 
 // Implementación especial del serializador para symbol_distribution
@@ -9,6 +9,7 @@
 #include "element_inspector.h"
 #include <utility>
 #include <iostream>
+#include <vector>
 
 namespace container {
 
@@ -43,6 +44,19 @@ public:
 	 */
 	virtual void update_element(const K &key, const T &value) = 0;
 
+	/**
+	 * Modifica un elemento si existe en el contenedor, o
+	 * lo agrega en caso contrario. Los contenedores deberían
+	 * redefinirlo para resolverlo con una única búsqueda.
+	 */
+	virtual void upsert_element(const K &key, const T &value) {
+		try {
+			update_element(key, value);
+		} catch (not_found_exception &not_found) {
+			add_element(key, value);
+		}
+	}
+
 	/**
 	 * Elimina un elemento existente en el contenedor.
 	 * Valida que el elemento exista, en caso contrario
@@ -59,6 +73,51 @@ public:
 	typedef std::pair<bool, T> search_result_type;
 	virtual search_result_type search_for_element(const K &key) = 0;
 
+	/**
+	 * Busca varios elementos en el contenedor. results[i] queda
+	 * con el resultado de buscar keys[i], igual que si se hubiese
+	 * llamado a search_for_element. Los contenedores pueden
+	 * redefinirlo para compartir las lecturas entre claves.
+	 */
+	virtual void search_for_elements(const std::vector<K> &keys, std::vector<search_result_type> &results) {
+		results.clear();
+		results.reserve(keys.size());
+		for (typename std::vector<K>::const_iterator it = keys.begin(); it != keys.end(); it++) {
+			results.push_back(search_for_element(*it));
+		}
+	}
+
+	/**
+	 * Guarda values[i] como el elemento de clave keys[i],
+	 * modificándolo si ya existe o agregándolo en caso contrario.
+	 * Los contenedores pueden redefinirlo para escribir una única
+	 * vez cada bloque afectado.
+	 */
+	virtual void upsert_elements(const std::vector<K> &keys, const std::vector<T> &values) {
+		for (typename std::vector<K>::size_type i = 0; i < keys.size(); i++) {
+			upsert_element(keys[i], values[i]);
+		}
+	}
+
+	/**
+	 * Igual que search_for_elements, pero recibe además en
+	 * hashes[i] el hash de keys[i] ya calculado (el mismo que
+	 * calcula hash::hash_key). Los contenedores que dispersan
+	 * las claves pueden usarlo para no volver a calcularlo.
+	 */
+	virtual void search_for_hashed_elements(const std::vector<K> &keys, const std::vector<unsigned int> &hashes, std::vector<search_result_type> &results) {
+		search_for_elements(keys, results);
+	}
+
+	/**
+	 * Igual que upsert_elements, pero recibe además en
+	 * hashes[i] el hash de keys[i] ya calculado (el mismo que
+	 * calcula hash::hash_key).
+	 */
+	virtual void upsert_hashed_elements(const std::vector<K> &keys, const std::vector<unsigned int> &hashes, const std::vector<T> &values) {
+		upsert_elements(keys, values);
+	}
+
 	/**
 	 * Vuelca el contenido de la estructura de datos en
 	 * un stream dado.
@@ -11,6 +11,9 @@
 #include "inner_node.h"
 #include "leaf_node.h"
 #include "node_factory.h"
+#include <vector>
+#include <utility>
+#include <stdexcept>
 
 namespace bplus{
 
@@ -38,14 +41,25 @@ private:
 	void handle_children_overflow(subtree_type *overflowded_node);
 	void try_replace_root();
 	subtree_type *interpret_block(const commons::io::block &b) const;
+
+	// Nodos de un nivel del árbol armado por bulk_load: la menor
+	// clave de cada nodo y su posición en el archivo
+	typedef std::vector<std::pair<K, int> > level_type;
+	typedef typename level_type::size_type level_index;
+
+	level_index fill_inner_node(inner_node_type &node, const level_type &children, level_index from, level_index to, double fill_factor) const;
+	void pack_inner_level(const level_type &children, double fill_factor, level_type &parents, std::vector<int> &allocated);
 public:
 
 	/**
 	 * Crea una nueva instancia de bplus_container
 	 * en el archivo de datos filename, con un tamaño
-	 * de bloque block_size
+	 * de bloque block_size. En modo read_only el archivo
+	 * tiene que existir, y cualquier modificación eleva
+	 * commons::io::ioexception. En modo temporary el archivo
+	 * se puede borrar apenas se crea el contenedor.
 	 */
-	explicit bplus_container(const char *filename, int block_size);
+	explicit bplus_container(const char *filename, int block_size, commons::io::open_mode mode = commons::io::read_write);
 
 	/**
 	 * Agrega un elemento al contenedor. Valida si el
@@ -61,6 +75,13 @@ public:
 	 */
 	void update_element(const K &key, const T &value);
 
+	/**
+	 * Modifica un elemento si existe en el contenedor, o
+	 * lo agrega en caso contrario, con un único recorrido
+	 * del árbol.
+	 */
+	void upsert_element(const K &key, const T &value);
+
 	/**
 	 * Elimina un elemento existente en el contenedor.
 	 * Valida que el elemento exista, en caso contrario
@@ -90,6 +111,27 @@ public:
 	 */
 	virtual void inspect(container::element_inspector<K, T> &inspector);
 
+	/**
+	 * Carga en el contenedor, que tiene que estar vacío, los pares
+	 * clave-valor de [first, last), ordenados por clave. El árbol
+	 * se arma de abajo hacia arriba: primero las hojas, en orden y
+	 * llenas hasta fill_factor (en porcentaje, como el factor de
+	 * carga de los nodos), y después cada nivel de nodos internos,
+	 * por lo que queda mucho más compacto que agregando los
+	 * elementos de a uno. Con un fill_factor menor a 100 queda
+	 * lugar en cada nodo para los elementos que se agreguen después.
+	 * Si las claves no están ordenadas eleva std::invalid_argument,
+	 * y si hay claves repetidas, duplicate_exception. Si un elemento
+	 * no entra en una hoja vacía, o las claves son tan grandes que
+	 * no se pueden repartir los nodos internos con al menos dos
+	 * hijos cada uno, eleva std::length_error. En todos los casos
+	 * el contenedor queda vacío, y los bloques que se llegaron a
+	 * ocupar se liberan para que los reutilice la próxima carga o
+	 * inserción; el archivo no se achica.
+	 */
+	template<typename InputIterator>
+	void bulk_load(InputIterator first, InputIterator last, double fill_factor = 100);
+
 	~bplus_container();
 };
 
@@ -102,8 +144,8 @@ void bplus_container<K, T>::block_file_initializer::initialize(commons::io::recy
 }
 
 template<typename K, typename T>
-bplus_container<K, T>::bplus_container(const char *filename, int block_size)
-: file(filename, block_size, block_file_initializer()) {
+bplus_container<K, T>::bplus_container(const char *filename, int block_size, commons::io::open_mode mode)
+: file(filename, block_size, block_file_initializer(), mode) {
 	commons::io::block root_node_block = file.read_block(0);
 	root_node = interpret_block(root_node_block);
 }
@@ -138,6 +180,21 @@ void bplus_container<K, T>::update_element(const K &key, const T &value) {
 	}
 }
 
+template<typename K, typename T>
+void bplus_container<K, T>::upsert_element(const K &key, const T &value) {
+	try {
+		if (root_node->recursive_upsert_element(key, value, &file)) {
+			// Intento reemplazar la raiz si está en overflow
+			try_replace_root();
+
+			// Guardo la raiz
+			file.write_block(0, root_node->get_root_block());
+		}
+	} catch (typename subtree_type::root_overflow_exception &o) {
+		handle_children_overflow(o.get_overflowded_subtree());
+	}
+}
+
 template<typename K, typename T>
 void bplus_container<K, T>::delete_element(const K &key) {
 	try {
@@ -169,6 +226,92 @@ void bplus_container<K, T>::inspect(container::element_inspector<K, T> &inspecto
 	root_node->recursive_inspect(inspector, &file);
 }
 
+template<typename K, typename T>
+template<typename InputIterator>
+void bplus_container<K, T>::bulk_load(InputIterator first, InputIterator last, double fill_factor) {
+	leaf_node_type *root_leaf = dynamic_cast<leaf_node_type *>(root_node);
+	if (root_leaf == NULL || !root_leaf->is_empty())
+		throw std::logic_error("Bulk loading requires an empty container");
+	if (fill_factor <= 0 || fill_factor > 100)
+		throw std::invalid_argument("The fill factor must be between 0 and 100");
+
+	// Posiciones que ocupó la carga, para liberarlas si falla
+	std::vector<int> allocated;
+	std::auto_ptr<subtree_type> new_root;
+	try {
+		level_type leaves;
+		leaf_node_type leaf(commons::io::block(file.get_block_size()));
+		leaf.clear();
+
+		// La primera hoja recién tiene posición cuando no entran todos
+		// los elementos en ella; si entran, es la raiz
+		int leaf_pointer = -1;
+		K leaf_key = K();
+		K previous_key = K();
+		bool loaded = false;
+
+		for (; first != last; ++first) {
+			std::pair<K, T> e = *first;
+			if (loaded && !(previous_key < e.first)) {
+				if (e.first < previous_key)
+					throw std::invalid_argument("Bulk loaded elements must be sorted by key");
+				throw typename parent::duplicate_exception();
+			}
+
+			if (!leaf.is_empty() && !leaf.can_hold(e.first, e.second, fill_factor)) {
+				// La hoja está llena: la grabo apuntando a la posición
+				// que sigue, donde va a ir la próxima hoja
+				if (leaf_pointer < 0)
+					allocated.push_back(leaf_pointer = file.reserve_block());
+				int next_leaf_pointer = file.reserve_block();
+				allocated.push_back(next_leaf_pointer);
+
+				leaf.set_next_leaf_pointer(next_leaf_pointer);
+				file.write_block(leaf_pointer, leaf.get_root_block());
+				leaves.push_back(std::make_pair(leaf_key, leaf_pointer));
+
+				leaf.clear();
+				leaf_pointer = next_leaf_pointer;
+			}
+
+			if (leaf.is_empty()) {
+				if (!leaf.can_hold(e.first, e.second, 100))
+					throw std::length_error("A bulk loaded element does not fit in a leaf");
+				leaf_key = e.first;
+			}
+			leaf.add_element(e.first, e.second);
+
+			previous_key = e.first;
+			loaded = true;
+		}
+
+		if (leaf_pointer < 0) {
+			new_root.reset(new leaf_node_type(leaf.get_root_block()));
+		} else {
+			file.write_block(leaf_pointer, leaf.get_root_block());
+			leaves.push_back(std::make_pair(leaf_key, leaf_pointer));
+
+			// Armo los niveles de nodos internos hasta que todo un
+			// nivel entra en un único nodo, que es la raiz
+			std::auto_ptr<inner_node_type> inner_root(new inner_node_type(commons::io::block(file.get_block_size())));
+			while (fill_inner_node(*inner_root, leaves, 0, leaves.size(), 100) < leaves.size()) {
+				level_type parents;
+				pack_inner_level(leaves, fill_factor, parents, allocated);
+				leaves.swap(parents);
+			}
+			new_root.reset(inner_root.release());
+		}
+	} catch (...) {
+		for (std::vector<int>::iterator it = allocated.begin(); it != allocated.end(); it++)
+			file.release_block(*it);
+		throw;
+	}
+
+	file.write_block(0, new_root->get_root_block());
+	delete root_node;
+	root_node = new_root.release();
+}
+
 template<typename K, typename T>
 bplus_container<K, T>::~bplus_container() {
 	delete root_node;
@@ -225,6 +368,58 @@ void bplus_container<K, T>::try_replace_root() {
 	}
 }
 
+template<typename K, typename T>
+typename bplus_container<K, T>::level_index bplus_container<K, T>::fill_inner_node(inner_node_type &node, const level_type &children, level_index from, level_index to, double fill_factor) const {
+	// El primer hijo va en el puntero de más a la izquierda, y
+	// cada uno de los siguientes con su menor clave. Siempre entra
+	// al menos una clave, para que el nodo tenga dos hijos
+	node.clear();
+	node.set_leftmost_pointer(children[from].second);
+
+	level_index i;
+	for (i = from + 1; i < to; i++) {
+		if (!node.can_hold(children[i].first, i > from + 1 ? fill_factor : 100)) {
+			if (i > from + 1)
+				break;
+			throw std::length_error("A bulk loaded key does not fit in an inner node");
+		}
+		node.insert_key_in_order(children[i].first, children[i].second);
+	}
+	return i;
+}
+
+template<typename K, typename T>
+void bplus_container<K, T>::pack_inner_level(const level_type &children, double fill_factor, level_type &parents, std::vector<int> &allocated) {
+	inner_node_type node(commons::io::block(file.get_block_size()));
+
+	// Primero reparto los hijos entre los nodos del nivel
+	std::vector<level_index> starts;
+	for (level_index i = 0; i < children.size(); i = fill_inner_node(node, children, i, children.size(), fill_factor))
+		starts.push_back(i);
+
+	// Si al último nodo le queda un único hijo, lo agrego al
+	// anterior si entra, o reparto entre los dos los hijos que
+	// tienen, para que a ninguno le quede uno solo
+	if (starts.size() > 1 && children.size() - starts.back() == 1) {
+		level_index previous = starts[starts.size() - 2];
+		if (fill_inner_node(node, children, previous, children.size(), 100) == children.size())
+			starts.pop_back();
+		else if (children.size() - previous >= 4)
+			starts.back() = previous + (children.size() - previous) / 2;
+		else
+			throw std::length_error("The bulk loaded keys are too large for two of them to fit in an inner node");
+	}
+
+	// Después grabo los nodos en orden
+	for (level_index n = 0; n < starts.size(); n++) {
+		level_index to = n + 1 < starts.size() ? starts[n + 1] : children.size();
+		if (fill_inner_node(node, children, starts[n], to, 100) != to)
+			throw std::length_error("The bulk loaded keys do not fit in an inner node");
+		parents.push_back(std::make_pair(children[starts[n]].first, file.append_block(node.get_root_block())));
+		allocated.push_back(parents.back().second);
+	}
+}
+
 template<typename K, typename T>
 typename bplus_container<K, T>::subtree_type *bplus_container<K, T>::interpret_block(const commons::io::block &b) const {
 	return node_factory::create_subtree_from_block<K, T>(b);
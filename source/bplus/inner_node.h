@@ -112,6 +112,13 @@ public:
 	 */
 	virtual int get_leftmost_pointer() const;
 
+	/**
+	 * Indica si la clave, con su puntero a derecha, entra en el
+	 * nodo sin que el factor de carga (en porcentaje, como
+	 * get_load_factor) supere load_factor
+	 */
+	bool can_hold(const K &key, double load_factor) const;
+
 	/**
 	 * Devuelve el bloque interno sobre el que opera este nodo
 	 */
@@ -133,6 +140,11 @@ public:
 	 */
 	virtual bool recursive_update_element(const K &key, const T &value, commons::io::recycling_block_file *file);
 
+	/**
+	 * Override subtree
+	 */
+	virtual bool recursive_upsert_element(const K &key, const T &value, commons::io::recycling_block_file *file);
+
 	/**
 	 * Override subtree
 	 */
@@ -271,16 +283,16 @@ void inner_node<K, T>::insert_key_in_order(const K &key, int right_pointer) {
 			current_position = get_element_start_index();
 			current_position < get_free_index();
 			current_position += sizeof(int) + commons::io::serialization_length<K>(inner_block, current_position)) {
-		// Deserializo la clave
-		K element_key = commons::io::deserialize<K>(inner_block, current_position);
+		// Comparo contra la clave serializada
+		int comparison = commons::io::compare_serialized(key, inner_block, current_position);
 
 		// Si la clave es la misma que la que estoy intentando
 		// usar... we are screwed!
-		if (element_key == key)
+		if (comparison == 0)
 			throw duplicate_exception();
 
 		// Si la clave es mayor a la que estoy intentando agregar
-		if (element_key > key) {
+		if (comparison < 0) {
 			// Tengo que meter mi clave justo antes de esta clave,
 			// así que hago espacio para que entre y salgo del bucle.
 			inner_block.make_gap(current_position, new_pair_size);
@@ -310,6 +322,13 @@ int inner_node<K, T>::get_leftmost_pointer() const {
 	return commons::io::deserialize<int>(inner_block, 2 * sizeof(int));
 }
 
+template<typename K, typename T>
+bool inner_node<K, T>::can_hold(const K &key, double load_factor) const {
+	int required = get_free_index() - get_element_start_index() + sizeof(int) + commons::io::serialization_length(key);
+	int total = inner_block.get_size() - get_element_start_index();
+	return static_cast<double>(required) * 100 <= load_factor * total;
+}
+
 template<typename K, typename T>
 const commons::io::block &inner_node<K, T>::get_block() const {
 	return inner_block;
@@ -349,27 +368,71 @@ bool inner_node<K, T>::recursive_update_element(const K &key, const T &value, co
 	// Busco el puntero en el que debería estar el elemento
 	int subtree_pointer = get_subtree_pointer_for(key);
 
-	try {
-		// Levanto el bloque del archivo y lo interpreto
-		commons::io::block b = file->read_block(subtree_pointer);
-		std::auto_ptr<subtree<K, T> > node(node_factory::create_subtree_from_block<K, T>(b));
+	// Levanto el bloque del archivo y lo interpreto
+	commons::io::block b = file->read_block(subtree_pointer);
+	std::auto_ptr<subtree<K, T> > node(node_factory::create_subtree_from_block<K, T>(b));
 
-		// Lo modifico y lo grabo si es necesario
-		if (node->recursive_update_element(key, value, file)) {
+	// Sólo el overflow del hijo se resuelve acá; si este nodo
+	// se desborda al resolver el underflow del hijo, lo tiene
+	// que resolver el padre
+	bool modified;
+	try {
+		modified = node->recursive_update_element(key, value, file);
+	} catch (typename subtree<K, T>::root_overflow_exception &o) {
+		handle_children_overflow(o.get_overflowded_subtree(), file, subtree_pointer);
+		return true;
+	}
 
-			if (node->get_load_factor() < 50.0) {
-				if (handle_children_underflow(&*node, subtree_pointer, file))
-					return true;
-			}
+	// Lo grabo si es necesario
+	if (modified) {
 
-			file->write_block(subtree_pointer, node->get_root_block());
+		if (node->get_load_factor() < 50.0) {
+			if (handle_children_underflow(&*node, subtree_pointer, file))
+				return true;
 		}
 
-		return false;
+		file->write_block(subtree_pointer, node->get_root_block());
+	}
+
+	return false;
+}
+
+template<typename K, typename T>
+bool inner_node<K, T>::recursive_upsert_element(const K &key, const T &value, commons::io::recycling_block_file *file) {
+	// Busco el puntero en el que debería estar el elemento
+	int subtree_pointer = get_subtree_pointer_for(key);
+
+	// Levanto el bloque del archivo y lo interpreto
+	commons::io::block b = file->read_block(subtree_pointer);
+	std::auto_ptr<subtree<K, T> > node(node_factory::create_subtree_from_block<K, T>(b));
+
+	// Sólo el overflow del hijo se resuelve acá; si este nodo
+	// se desborda al resolver el underflow del hijo, lo tiene
+	// que resolver el padre
+	double previous_load_factor = node->get_load_factor();
+	bool modified;
+	try {
+		modified = node->recursive_upsert_element(key, value, file);
 	} catch (typename subtree<K, T>::root_overflow_exception &o) {
 		handle_children_overflow(o.get_overflowded_subtree(), file, subtree_pointer);
 		return true;
 	}
+
+	// Lo grabo si es necesario. Sólo puede quedar en underflow
+	// si el elemento se achicó; si se agregó, el nodo no se
+	// intenta fusionar
+	if (modified) {
+
+		double load_factor = node->get_load_factor();
+		if (load_factor < previous_load_factor && load_factor < 50.0) {
+			if (handle_children_underflow(&*node, subtree_pointer, file))
+				return true;
+		}
+
+		file->write_block(subtree_pointer, node->get_root_block());
+	}
+
+	return false;
 }
 
 template<typename K, typename T>
@@ -625,11 +688,9 @@ int inner_node<K, T>::get_key_position(const K &key) const {
 			int current_position = get_element_start_index();
 			current_position < get_free_index();
 			current_position += sizeof(int) + commons::io::serialization_length<K>(inner_block, current_position)) {
-		// Levanto la clave en la que estoy parado
-		K current_key = commons::io::deserialize<K>(inner_block, current_position);
-
-		// Si es la que estoy buscando... ya estamos!
-		if (current_key == key)
+		// Si la clave en la que estoy parado es la que
+		// estoy buscando... ya estamos!
+		if (commons::io::compare_serialized(key, inner_block, current_position) == 0)
 			return current_position;
 	}
 
@@ -658,12 +719,9 @@ int inner_node<K, T>::get_subtree_pointer_for(const K &key) const {
 			int current_position = get_element_start_index();
 			current_position < get_free_index();
 			current_position += sizeof(int) + commons::io::serialization_length<K>(inner_block, current_position)) {
-		// Deserializo la clave
-		K element_key = commons::io::deserialize<K>(inner_block, current_position);
-
 		// Si es mayor... el elemento va en el nodo apuntado
 		// por el puntero inmediatamente anterior
-		if (element_key > key) {
+		if (commons::io::compare_serialized(key, inner_block, current_position) < 0) {
 			return commons::io::deserialize<int>(inner_block, current_position - sizeof(int));
 		}
 	}
@@ -848,7 +906,7 @@ template<typename K, typename T>
 void inner_node<K, T>::copy_elements(int from, int to, inner_node<K, T> *node) {
 	for (int i = from; i < to; i += sizeof(int) + commons::io::serialization_length<K>(inner_block, i)) {
 		K key = commons::io::deserialize<K>(inner_block, i);
-		int pointer = commons::io::deserialize<int>(inner_block, i + sizeof(int));
+		int pointer = commons::io::deserialize<int>(inner_block, i + commons::io::serialization_length(key));
 
 		node->insert_key_in_order(key, pointer);
 	}
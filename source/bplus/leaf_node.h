@@ -32,11 +32,6 @@ protected:
 	 */
 	virtual int get_metadata_length() const;
 
-	/**
-	 * Override element_container_block
-	 */
-	virtual int make_room_for_element(const K &key, const T &value);
-
 	/**
 	 * Override element_container_block
 	 */
@@ -77,6 +72,13 @@ public:
 	 */
 	void set_next_leaf_pointer(int leaf_pointer);
 
+	/**
+	 * Indica si el elemento entra en el nodo sin que el factor
+	 * de carga (en porcentaje, como get_load_factor) supere
+	 * load_factor
+	 */
+	bool can_hold(const K &key, const T &value, double load_factor) const;
+
 	/**
 	 * Override subtree
 	 */
@@ -87,6 +89,11 @@ public:
 	 */
 	virtual bool recursive_update_element(const K &key, const T &value, commons::io::recycling_block_file *file);
 
+	/**
+	 * Override subtree
+	 */
+	virtual bool recursive_upsert_element(const K &key, const T &value, commons::io::recycling_block_file *file);
+
 	/**
 	 * Override subtree
 	 */
@@ -167,6 +174,15 @@ void leaf_node<K, T>::set_next_leaf_pointer(int leaf_pointer) {
 	commons::io::serialize(leaf_pointer, parent::get_inner_block_pointer(), static_cast<int>(sizeof(int)));
 }
 
+template<typename K, typename T>
+bool leaf_node<K, T>::can_hold(const K &key, const T &value, double load_factor) const {
+	// Lo que ocupa el nodo con el registro y su entrada del directorio
+	int required = parent::get_free_index() - parent::get_element_start_index() + parent::get_directory_length() +
+			commons::io::serialization_length(key) + commons::io::serialization_length(value) + sizeof(int);
+	int total = parent::get_inner_block().get_size() - parent::get_element_start_index();
+	return static_cast<double>(required) * 100 <= load_factor * total;
+}
+
 template<typename K, typename T>
 bool leaf_node<K, T>::recursive_add_element(const K &key, const T &value, commons::io::recycling_block_file *file) {
 	// Cuando se está agregando recursivamente un elemento,
@@ -186,6 +202,14 @@ bool leaf_node<K, T>::recursive_update_element(const K &key, const T &value, com
 	return true;
 }
 
+template<typename K, typename T>
+bool leaf_node<K, T>::recursive_upsert_element(const K &key, const T &value, commons::io::recycling_block_file *file) {
+	// Cuando la llamada recursiva llega a una hoja, el elemento
+	// está en esta hoja o tiene que agregarse en ella
+	parent::upsert_element(key, value);
+	return true;
+}
+
 template<typename K, typename T>
 bool leaf_node<K, T>::recursive_delete_element(const K &key, commons::io::recycling_block_file *file) {
 	// Cuando se está eliminadno recursivamente un elemento,
@@ -302,7 +326,7 @@ commons::io::block leaf_node<K, T>::get_root_block() const {
 
 template<typename K, typename T>
 double leaf_node<K, T>::get_load_factor(){
-	int used = parent::get_free_index() - parent::get_element_start_index();
+	int used = parent::get_free_index() - parent::get_element_start_index() + parent::get_directory_length();
 	int total = parent::get_inner_block().get_size() - parent::get_element_start_index();
 	return static_cast<double>(used) * 100 / static_cast<double>(total);
 }
@@ -361,43 +385,13 @@ int leaf_node<K, T>::get_metadata_length() const {
 		sizeof(int);  // Puntero al siguiente elemento
 }
 
-template<typename K, typename T>
-int leaf_node<K, T>::make_room_for_element(const K &key, const T &value) {
-	// Arranco con el primer elemento
-	int current_record_position = parent::get_element_start_index();
-
-	while (current_record_position < parent::get_free_index()) {
-		// Levanto la clave actual
-		K current_key = commons::io::deserialize<K>(parent::get_inner_block(), current_record_position);
-		// Si estoy en la primer clave que es mayor a la que tengo que
-		// insertar, paro acá
-		if (current_key > key) {
-			// Hago espacio para el elemento
-			int key_length = commons::io::serialization_length(key);
-			int value_length = commons::io::serialization_length(value);
-			parent::get_inner_block_pointer()->make_gap(current_record_position, key_length + value_length);
-			// Devuelvo la posición donde hay que insertar
-			return current_record_position;
-		} else {
-			// Sigo para adelante
-			int key_length = commons::io::serialization_length(current_key);
-			int value_length = commons::io::serialization_length<T>(parent::get_inner_block(), current_record_position + key_length);
-			current_record_position += key_length + value_length;
-		}
-	}
-
-	// Si llegamos acá, no había ninguna clave mayor en la hoja.
-	// La posición donde insertar el elemento es la última.
-	return parent::get_free_index();
-}
-
 template<typename K, typename T>
 void leaf_node<K, T>::handle_insertion_overflow(const K &key, const T &value, int total_required_size) {
 	// Creo un nuevo leaf_node en el que entre el elemento
 	leaf_node<K, T> *overflowded_node = new leaf_node<K, T>(commons::io::block(total_required_size));
 
 	// Copio el estado del leaf_node actual
-	parent::get_inner_block().copy_to_block(*overflowded_node->get_block_pointer());
+	parent::copy_to_container(*overflowded_node);
 
 	// Agrego el elemento en este nodo, que si tiene capacidad
 	overflowded_node->add_element(key, value);
@@ -412,7 +406,7 @@ void leaf_node<K, T>::handle_modification_overflow(const K &key, const T &value,
 	leaf_node<K, T> *overflowded_node = new leaf_node<K, T>(commons::io::block(total_required_size));
 
 	// Copio el estado del leaf_node actual
-	parent::get_inner_block().copy_to_block(*overflowded_node->get_block_pointer());
+	parent::copy_to_container(*overflowded_node);
 
 	// Agrego el elemento en este nodo, que si tiene capacidad
 	overflowded_node->update_element(key, value);
@@ -423,31 +417,30 @@ void leaf_node<K, T>::handle_modification_overflow(const K &key, const T &value,
 
 template<typename K, typename T>
 int leaf_node<K, T>::get_optimal_splitting_position() {
-	// Busco la posición ideal en donde partir, que dejaría
-	// el 50% cargado cada nodo
-	int halfway_position = (parent::get_free_index() - parent::get_element_start_index()) / 2 + parent::get_element_start_index();
-
-	// Ahora recorro los elementos buscando el elemento en el que recae
-	// la posición óptima.
-	int previous_position = 0;
-	int previous_element = 0;
-	int current_position = parent::get_element_start_index();
+	// Busco la cantidad de bytes que dejaría el 50% cargado
+	// cada nodo
+	int halfway_length = (parent::get_free_index() - parent::get_element_start_index()) / 2;
+
+	// Ahora recorro los elementos en orden acumulando su longitud,
+	// buscando el elemento en el que recae la posición óptima.
+	int previous_length = 0;
+	int current_length = 0;
 	int current_element = 0;
 	do
 	{
-		previous_position = current_position;
-		previous_element = current_element;
-		current_position = parent::get_next_element_index(previous_position);
+		int position = parent::get_element_position(current_element);
+		previous_length = current_length;
+		current_length += parent::get_next_element_index(position) - position;
 		current_element++;
 
-		if (previous_position <= halfway_position && current_position >= halfway_position)
+		if (previous_length <= halfway_length && current_length >= halfway_length)
 			break;
-	} while (current_position < parent::get_free_index());
+	} while (current_element < parent::get_element_count());
 
 	// Calculo la posición más cercana a la óptima
 	return
-		halfway_position - previous_position < current_position - halfway_position ?
-			previous_element :
+		halfway_length - previous_length < current_length - halfway_length ?
+			current_element - 1 :
 			current_element;
 }
 
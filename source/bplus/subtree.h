@@ -91,6 +91,15 @@ public:
 	 */
 	virtual bool recursive_update_element(const K &key, const T &value, commons::io::recycling_block_file *file) = 0;
 
+	/**
+	 * Recursivamente modifica un elemento en el nodo o
+	 * en sus descendientes, o lo agrega si no existe.
+	 * Devuelve true si el nodo fue modificado en el
+	 * proceso, lo que requiere que dicho nodo se baje
+	 * al archivo.
+	 */
+	virtual bool recursive_upsert_element(const K &key, const T &value, commons::io::recycling_block_file *file) = 0;
+
 	/**
 	 * Recursivamente elimina un elemento del
 	 * nodo o de sus descendentes, según corresponda.
@@ -4,12 +4,23 @@
 ******************************************************************************/
 #include "compression_client.h"
 #include "../utils/stream_utils.h"
+#include "../utils/string_utils.h"
 #include "../io/stream_char_source.h"
 #include "../io/stream_char_destination.h"
+#include "../io/mapped_char_source.h"
+#include "../io/ioexception.h"
 #include "../io/stream_binary_source.h"
 #include "../io/stream_binary_destination.h"
 #include "../../ppmc/compressor.h"
 #include "../../ppmc/decompressor.h"
+#include "../../ppmc/segmented_compressor.h"
+#include "../../ppmc/segmented_decompressor.h"
+#include "../../ppmc/segmented_format.h"
+#include "../../ppmc/dictionary.h"
+#include "../../config/config.h"
+#include "../concurrency/thread_pool.h"
+#include <cstdlib>
+#include <deque>
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -21,12 +32,15 @@ using namespace std;
 namespace {
 
 const char *compress_description = "Su presencia indica que el cliente se está ejecutando en modo compresión. "
-		"Indica además la cantidad máxima de contextos que deben utilizarse.";
+		"Indica además la cantidad máxima de contextos que deben utilizarse, entre 0 y 255.";
 
 const char *decompress_description = "Su presencia indica que el cliente se está ejecutando en modo descompresión. "
-		"Indica además la cantidad máxima de contextos que deben utilizarse.";
+		"Indica además la cantidad máxima de contextos que deben utilizarse, entre 0 y 255.";
 
-const char *filename_description = "The file in which we will create the data structure";
+const char *filename_description = "El archivo a comprimir / descomprimir. Sin archivo, o con \"-\", se lee "
+		"de la entrada estándar y se escribe en la salida estándar. Si los contextos se guardan en disco (ppmch, "
+		"ppmct), ocupan en $TMPDIR espacio proporcional a la entrada, en archivos que se borran apenas se abren; "
+		"ppmcm los mantiene en memoria, con un límite fijo.";
 
 const char *show_st_description = "Su presencia indica que el cliente emitirá estadísticas detalladas de la "
 		"compresión / descompresión, como cantidad de matchs por contexto y tamaño antes y después de comprimir.";
@@ -34,6 +48,82 @@ const char *show_st_description = "Su presencia indica que el cliente emitirá e
 const char *verbose_description = "Su presencia indica que el cliente emitirá información detallada de la configuración "
 		"de la tabla de contextos luego de comprimir / descomprimir.";
 
+const char *segment_size_description = "Su presencia indica que el archivo se comprime por segmentos independientes "
+		"de la cantidad de bytes dada, en paralelo. Con 0 se comprime en forma secuencial.";
+
+const char *threads_description = "Indica la cantidad de threads que se utilizan para comprimir / descomprimir "
+		"por segmentos. Con 0 se utiliza un thread por procesador.";
+
+const char *range_description = "Descomprime sólo len bytes a partir de la posición start del original. "
+		"Requiere un archivo comprimido por segmentos.";
+
+/**
+ * Interpreta un rango de la forma "start:len"
+ */
+std::pair<uint64_t, uint64_t> parse_range(const std::string &value) {
+	std::vector<std::string> parts;
+	commons::utils::strings::split(value, ":", parts);
+
+	std::pair<uint64_t, uint64_t> result;
+	if (parts.size() == 2) {
+		std::stringstream start(parts[0]);
+		std::stringstream length(parts[1]);
+		char extra;
+		if (start >> result.first && !(start >> extra) && length >> result.second && !(length >> extra))
+			return result;
+	}
+	throw TCLAP::ArgParseException("Range must have the form start:len", "range");
+}
+
+const char *train_description = "Entrena el diccionario guardado en path con los archivos dados, en lugar de "
+		"comprimirlos. Si el diccionario no existe, lo crea. Requiere el modo compresión.";
+
+const char *dictionary_description = "Comprime / descomprime partiendo del modelo de contextos del diccionario "
+		"guardado en path, que no se modifica. Hay que usar el mismo diccionario para comprimir y descomprimir.";
+
+const char *files_description = "Archivos a comprimir / descomprimir en modo batch, en paralelo y cada uno "
+		"con su propia tabla de contextos.";
+
+/**
+ * Compresión o descompresión de un archivo del modo batch, con
+ * su propio contenedor
+ */
+struct batch_job : public commons::concurrency::task {
+	bool compressing;
+	int max_contexts;
+	std::string filename;
+	container::associative_container<std::string, arithmetic::symbol_distribution> *container;
+
+	batch_job(bool compressing, int max_contexts, const std::string &filename,
+		container::associative_container<std::string, arithmetic::symbol_distribution> *container)
+	: compressing(compressing), max_contexts(max_contexts), filename(filename), container(container) {}
+
+	virtual void run() {
+		if (compressing) {
+			commons::io::mapped_char_source input(filename.c_str());
+			ofstream output_stream((filename + ".compressed").c_str(), ios_base::out | ios_base::binary);
+			commons::io::stream_binary_destination output(output_stream);
+
+			ppmc::compressor compressor(output, max_contexts, container);
+			compressor.compress(input);
+		} else {
+			ifstream input_stream(filename.c_str(), ios_base::in | ios_base::binary);
+			if (!input_stream)
+				throw commons::io::ioexception("Could not open '" + filename + "'");
+			// Los segmentos ya se descomprimen en paralelo entre sí
+			if (ppmc::segmented::is_segmented(input_stream))
+				throw commons::io::ioexception("Segmented files must be decompressed one at a time");
+			commons::io::stream_binary_source input(input_stream);
+
+			ofstream output_stream((filename + ".decompressed").c_str(), ios_base::out | ios_base::binary);
+			commons::io::stream_char_destination output(output_stream);
+
+			ppmc::decompressor decompressor(input, max_contexts, container);
+			decompressor.decompress(output);
+		}
+	}
+};
+
 struct statistics_accumulator : public container::element_inspector<std::string, arithmetic::symbol_distribution> {
 	typedef std::map<unsigned int, unsigned int> match_container;
 	match_container matches;
@@ -55,23 +145,37 @@ struct statistics_accumulator : public container::element_inspector<std::string,
 
 };
 
-compression_client::compression_client(context_container *cont)
+compression_client::compression_client(ppmc::context_container_factory *factory)
 : parser("PPMC compressor", ' ', "1.0"),
   compress_switch("c", "compress", compress_description, true, 0, "integer"),
   decompress_switch("d", "decompress", decompress_description, true, 0, "integer"),
-  filename("f", "filename", filename_description, true, "", "filepath"),
+  filename("f", "filename", filename_description, false, "-", "filepath"),
   show_statistics_switch("e", "statistics", show_st_description),
   verbose_switch("v", "verbose", verbose_description),
-  c(cont) {
+  segment_size("s", "segment-size", segment_size_description, false, 0, "integer"),
+  threads("j", "threads", threads_description, false, 0, "integer"),
+  range("r", "range", range_description, false, "", "start:len"),
+  train("t", "train", train_description, false, "", "path"),
+  dictionary("D", "dictionary", dictionary_description, false, "", "path"),
+  files("files", files_description, false, "filepath"),
+  factory(factory),
+  c(0) {
 
 }
 
-void compression_client::run(int argc, char **argv) {
+int compression_client::run(int argc, char **argv) {
+	int status = EXIT_SUCCESS;
 	try {
 		// Agrego los argumentos directos
 		parser.add(filename);
 		parser.add(show_statistics_switch);
 		parser.add(verbose_switch);
+		parser.add(segment_size);
+		parser.add(threads);
+		parser.add(range);
+		parser.add(train);
+		parser.add(dictionary);
+		parser.add(files);
 		// Agrego los argumentos mutuamente excluyentes
 		vector<TCLAP::Arg *>args;
 		args.push_back(&compress_switch);
@@ -81,37 +185,148 @@ void compression_client::run(int argc, char **argv) {
 		// Parseo los argumentos
 		parser.parse(argc, argv);
 
-		if (compress_switch.isSet()) {
+		if (filename.isSet())
+			inputs.push_back(filename.getValue());
+		inputs.insert(inputs.end(), files.getValue().begin(), files.getValue().end());
+
+		// El máximo de contextos se guarda en un byte del formato
+		// por segmentos
+		int max_contexts = compress_switch.isSet() ? compress_switch.getValue() : decompress_switch.getValue();
+		if (max_contexts < 0 || max_contexts > static_cast<int>(ppmc::segmented::max_contexts_limit))
+			throw TCLAP::ArgParseException("The maximum number of contexts must be between 0 and 255",
+				compress_switch.isSet() ? "compress" : "decompress");
+
+		// La salida estándar es la salida comprimida / descomprimida
+		if (is_streaming() && (show_statistics_switch.isSet() || verbose_switch.isSet()))
+			throw TCLAP::ArgParseException("Statistics and verbose output need a file", "filename");
+
+		if (dictionary.isSet()) {
+			// Los cambios de cada compresión van a la misma clase de
+			// contenedor que se usaría sin diccionario
+			dictionary_factory.reset(new ppmc::dictionary_container_factory(dictionary.getValue(), *factory, *factory));
+		}
+
+		if (train.isSet()) {
+			if (!compress_switch.isSet() || dictionary.isSet() || show_statistics_switch.isSet() || segment_size.isSet() || range.isSet())
+				throw TCLAP::ArgParseException("Training needs -c and does not support -D, -e, -s or -r", "train");
+			do_training();
+		} else if (inputs.size() > 1) {
+			if (show_statistics_switch.isSet() || verbose_switch.isSet() || segment_size.isSet() || range.isSet())
+				throw TCLAP::ArgParseException("Batch mode does not support -e, -v, -s or -r", "files");
+			if (!do_batch())
+				status = EXIT_FAILURE;
+		} else if (compress_switch.isSet()) {
 			do_compression();
 		} else if (decompress_switch.isSet()) {
 			do_decompression();
 		}
 
 	} catch (TCLAP::ArgParseException &e) {
-		cout << e.error() << endl;
+		cerr << e.error() << endl;
+		status = EXIT_FAILURE;
+	} catch (commons::io::ioexception &e) {
+		cerr << e.what() << endl;
+		status = EXIT_FAILURE;
+	} catch (std::runtime_error &e) {
+		// Por ejemplo, si no se pudo crear ningún thread
+		cerr << e.what() << endl;
+		status = EXIT_FAILURE;
 	}
+
+	if (c) {
+		// El diccionario entrenado se abrió directamente con la fábrica
+		ppmc::context_container_factory &owner = train.isSet() ? *factory : container_factory();
+		owner.destroy_container(c);
+		c = 0;
+	}
+
+	return status;
+}
+
+bool compression_client::is_streaming() {
+	return inputs.empty() || (inputs.size() == 1 && inputs[0] == "-");
+}
+
+const std::string &compression_client::input_filename() {
+	return inputs[0];
+}
+
+ppmc::context_container_factory &compression_client::container_factory() {
+	if (dictionary_factory.get() != NULL)
+		return *dictionary_factory;
+	return *factory;
 }
 
 void compression_client::do_compression() {
-	int max_contexts = compress_switch.getValue();
+	if (is_streaming()) {
+		commons::io::stream_char_source input(cin);
+		compress(input, cout);
+		return;
+	}
+
 	stringstream compressed_filename_builder;
-	compressed_filename_builder << filename.getValue() << ".compressed";
+	compressed_filename_builder << input_filename() << ".compressed";
 	string compressed_filename = compressed_filename_builder.str();
 
 	{
-		ifstream input_stream(filename.getValue().c_str());
-		commons::io::stream_char_source input(input_stream);
+		commons::io::mapped_char_source input(input_filename().c_str());
+		ofstream output(compressed_filename.c_str(), ios_base::out | ios_base::binary);
+		compress(input, output);
+	}
 
-		ofstream output_stream(compressed_filename.c_str(), ios_base::out | ios_base::binary);
-		commons::io::stream_binary_destination output(output_stream);
+	if (show_statistics_switch.isSet()) {
+		print_statistics(input_filename(), compressed_filename);
+	}
+
+	if (verbose_switch.isSet()) {
+		print_container();
+	}
+}
+
+void compression_client::compress(commons::io::char_source &input, std::ostream &output) {
+	int max_contexts = compress_switch.getValue();
+
+	if (segment_size.getValue() > 0) {
+		commons::concurrency::thread_pool pool(threads.getValue());
+		ppmc::segmented_compressor compressor(output, max_contexts, segment_size.getValue(), container_factory(), pool);
+
+		compressor.compress(input);
+	} else {
+		commons::io::stream_binary_destination destination(output);
 
-		ppmc::compressor compressor(output, max_contexts, c);
+		c = container_factory().create_container();
+		ppmc::compressor compressor(destination, max_contexts, c);
 
 		compressor.compress(input);
 	}
+}
+
+void compression_client::do_decompression() {
+	if (range.isSet()) {
+		do_range_decompression();
+		return;
+	}
+
+	if (is_streaming()) {
+		decompress(cin, cout);
+		return;
+	}
+
+	stringstream decompressed_filename_builder;
+	decompressed_filename_builder << input_filename() << ".decompressed";
+	string decompressed_filename = decompressed_filename_builder.str();
+
+	{
+		ifstream input(input_filename().c_str(), ios_base::in | ios_base::binary);
+		if (!input)
+			throw commons::io::ioexception("Could not open '" + input_filename() + "'");
+
+		ofstream output(decompressed_filename.c_str(), ios_base::out | ios_base::binary);
+		decompress(input, output);
+	}
 
 	if (show_statistics_switch.isSet()) {
-		print_statistics(filename.getValue(), compressed_filename);
+		print_statistics(decompressed_filename, input_filename());
 	}
 
 	if (verbose_switch.isSet()) {
@@ -119,37 +334,117 @@ void compression_client::do_compression() {
 	}
 }
 
-void compression_client::do_decompression() {
-	int max_contexts = decompress_switch.getValue();
+void compression_client::decompress(std::istream &input, std::ostream &output) {
+	commons::io::stream_char_destination destination(output);
+
+	if (ppmc::segmented::is_segmented(input)) {
+		// El máximo de contextos se toma del encabezado del archivo
+		commons::concurrency::thread_pool pool(threads.getValue());
+		ppmc::segmented_decompressor decompressor(input, container_factory(), pool);
+
+		decompressor.decompress(destination);
+	} else {
+		commons::io::stream_binary_source source(input);
+
+		c = container_factory().create_container();
+		ppmc::decompressor decompressor(source, decompress_switch.getValue(), c);
+
+		decompressor.decompress(destination);
+	}
+}
+
+void compression_client::do_range_decompression() {
+	if (is_streaming())
+		throw commons::io::ioexception("Range decompression requires a file");
+
+	std::pair<uint64_t, uint64_t> bounds = parse_range(range.getValue());
 	stringstream decompressed_filename_builder;
-	decompressed_filename_builder << filename.getValue() << ".decompressed";
+	decompressed_filename_builder << input_filename() << ".decompressed";
 	string decompressed_filename = decompressed_filename_builder.str();
 
-	{
-		ifstream input_stream(filename.getValue().c_str(), ios_base::in | ios_base::binary);
-		commons::io::stream_binary_source input(input_stream);
+	ifstream input(input_filename().c_str(), ios_base::in | ios_base::binary);
+	if (!ppmc::segmented::is_segmented(input))
+		throw commons::io::ioexception("Range decompression requires a segmented file");
 
-		ofstream output_stream(decompressed_filename.c_str());
-		commons::io::stream_char_destination output(output_stream);
+	ofstream output_stream(decompressed_filename.c_str(), ios_base::out | ios_base::binary);
+	commons::io::stream_char_destination output(output_stream);
 
-		ppmc::decompressor decompressor(input, max_contexts, c);
+	commons::concurrency::thread_pool pool(threads.getValue());
+	ppmc::segmented_decompressor decompressor(input, container_factory(), pool);
+
+	decompressor.decompress_range(output, bounds.first, bounds.second);
+}
 
-		decompressor.decompress(output);
+bool compression_client::do_batch() {
+	bool compressing = compress_switch.isSet();
+	int max_contexts = compressing ? compress_switch.getValue() : decompress_switch.getValue();
+
+	commons::concurrency::thread_pool pool(threads.getValue());
+
+	// Se mantienen en vuelo a lo sumo dos archivos por thread; los
+	// contenedores se crean y destruyen siempre desde este thread
+	std::deque<batch_job *> pending;
+	std::deque<batch_job *>::size_type window = 2 * pool.get_thread_count();
+	std::vector<std::string>::size_type next = 0;
+	bool succeeded = true;
+
+	while (next < inputs.size() || !pending.empty()) {
+		if (next < inputs.size() && pending.size() < window) {
+			batch_job *job = new batch_job(compressing, max_contexts, inputs[next++], container_factory().create_container());
+			pool.submit(job);
+			pending.push_back(job);
+			continue;
+		}
 
+		batch_job *job = pending.front();
+		pending.pop_front();
+		pool.wait(job);
+		if (job->has_failed()) {
+			cerr << job->filename << ": " << job->get_error() << endl;
+			succeeded = false;
+		}
+		container_factory().destroy_container(job->container);
+		delete job;
 	}
 
-	if (show_statistics_switch.isSet()) {
-		print_statistics(decompressed_filename, filename.getValue());
+	return succeeded;
+}
+
+void compression_client::do_training() {
+	// El diccionario siempre se guarda con los contenedores de la
+	// fábrica, aunque el corpus venga de la entrada estándar
+	c = factory->open_container(train.getValue(), commons::io::read_write);
+
+	if (is_streaming()) {
+		commons::io::stream_char_source input(cin);
+		ppmc::dictionary::train(input, compress_switch.getValue(), c);
+	} else {
+		for (std::vector<std::string>::iterator it = inputs.begin(); it != inputs.end(); it++) {
+			commons::io::mapped_char_source input(it->c_str());
+			ppmc::dictionary::train(input, compress_switch.getValue(), c);
+		}
 	}
 
+	// El diccionario ya no cambia, así que se compacta; para eso
+	// tiene que estar cerrado. c se limpia antes, porque cerrarlo
+	// puede fallar y el contenedor se destruye igual
+	ppmc::context_container_factory::context_container *trained = c;
+	c = 0;
+	factory->destroy_container(trained);
+	factory->compact_container(train.getValue());
+
 	if (verbose_switch.isSet()) {
+		c = factory->open_container(train.getValue(), commons::io::read_only);
 		print_container();
 	}
 }
 
 void compression_client::print_statistics(const std::string &uncompressed_filename, const std::string &compressed_filename) {
+	// En las compresiones por segmentos no queda un único modelo
+	// de contextos del que sacar los matches
 	statistics_accumulator accumulator;
-	c->inspect(accumulator);
+	if (c)
+		c->inspect(accumulator);
 
 	int uncompressed_size = commons::utils::streams::file_size(uncompressed_filename);
 	int compressed_size = commons::utils::streams::file_size(compressed_filename);
@@ -175,5 +470,9 @@ void compression_client::print_container() {
 	std::cout << "********************************" << std::endl;
 	std::cout << "Estado de la tabla de contextos" << std::endl;
 	std::cout << "********************************" << std::endl;
-	c->dump_to_stream(std::cout);
+	if (c) {
+		c->dump_to_stream(std::cout);
+	} else {
+		std::cout << "Cada segmento utiliza su propia tabla de contextos" << std::endl;
+	}
 }
@@ -6,8 +6,11 @@
 #define __COMMONS_CMDLINE_COMPRESSION_CLIENT_H_INCLUDED__
 
 #include "../../dependencies/tclap/CmdLine.h"
-#include "../../associative_container.h"
-#include "../../arithmetic/symbol_distribution.h"
+#include "../../ppmc/context_container_factory.h"
+#include "../../ppmc/dictionary_container_factory.h"
+#include "../io/char_source.h"
+#include <iostream>
+#include <memory>
 
 namespace commons {
 namespace cmdline {
@@ -15,6 +18,21 @@ namespace cmdline {
 /**
  * Cliente de la linea de comandos para interactuar
  * con un compresor ppmc.
+ *
+ * Sin archivo (o con "-f -") trabaja en modo streaming: lee de la
+ * entrada estándar y escribe en la salida estándar. Los contextos
+ * se guardan en los mismos contenedores de la fábrica que con un
+ * archivo, porque la salida depende del contenedor (el trie, por
+ * ejemplo, se vacía al llegar a su límite de memoria).
+ *
+ * Con varios archivos trabaja en modo batch: comprime o descomprime
+ * cada archivo por separado, en paralelo, cada uno con su propio
+ * compresor y su propio contenedor de la fábrica.
+ *
+ * Con un diccionario, cada compresión parte del modelo de contextos
+ * del diccionario en lugar de un modelo vacío. El diccionario se
+ * entrena antes con el modo de entrenamiento, y se guarda con el
+ * formato de los contenedores de la fábrica.
  */
 class compression_client {
 	TCLAP::CmdLine parser;
@@ -24,30 +42,61 @@ class compression_client {
 	TCLAP::ValueArg<std::string> filename;
 	TCLAP::SwitchArg show_statistics_switch;
 	TCLAP::SwitchArg verbose_switch;
+	TCLAP::ValueArg<unsigned int> segment_size;
+	TCLAP::ValueArg<unsigned int> threads;
+	TCLAP::ValueArg<std::string> range;
+	TCLAP::ValueArg<std::string> train;
+	TCLAP::ValueArg<std::string> dictionary;
+	TCLAP::UnlabeledMultiArg<std::string> files;
 
-	typedef container::associative_container<std::string, arithmetic::symbol_distribution> context_container;
+	// Archivos a procesar, de -f y de los argumentos sueltos
+	std::vector<std::string> inputs;
+
+	typedef ppmc::context_container_factory::context_container context_container;
+	ppmc::context_container_factory *factory;
+	std::auto_ptr<ppmc::dictionary_container_factory> dictionary_factory;
+	// Contenedor de la última compresión secuencial, para las
+	// estadísticas; es nulo en las compresiones por segmentos
 	context_container *c;
 
+	bool is_streaming();
+
+	const std::string &input_filename();
+
+	ppmc::context_container_factory &container_factory();
+
 	void do_compression();
 
+	void compress(commons::io::char_source &input, std::ostream &output);
+
 	void do_decompression();
 
+	void decompress(std::istream &input, std::ostream &output);
+
+	void do_range_decompression();
+
+	bool do_batch();
+
+	void do_training();
+
 	void print_statistics(const std::string &uncompressed_filename, const std::string &compressed_filename);
 
 	void print_container();
 public:
 	/**
-	 * Crea un nuevo cliente de compresión que utiliza el
-	 * contenedor asociativo dado.
+	 * Crea un nuevo cliente de compresión que utiliza
+	 * contenedores asociativos creados por la fábrica dada.
 	 */
-	compression_client(context_container *cont);
+	compression_client(ppmc::context_container_factory *factory);
 
 	/**
 	 * Ejecuta el cliente, interactuando con el usuario
 	 * a través de la linea de comandos y llamando a los
-	 * callbacks necesarios para procesar la entrada
+	 * callbacks necesarios para procesar la entrada.
+	 * Devuelve EXIT_SUCCESS, o EXIT_FAILURE si hubo algún
+	 * error (ya informado por la salida de errores).
 	 */
-	void run(int argc, char **argv);
+	int run(int argc, char **argv);
 };
 
 };
@@ -0,0 +1,136 @@
+/******************************************************************************
+ * thread_pool.cpp
+ * 		Definiciones de las clases commons::concurrency::task y
+ * 		commons::concurrency::thread_pool
+******************************************************************************/
+#include "thread_pool.h"
+#include <unistd.h>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+
+using namespace commons::concurrency;
+
+task::task()
+: finished(false) {
+
+}
+
+bool task::has_failed() const {
+	return !error.empty();
+}
+
+const std::string &task::get_error() const {
+	return error;
+}
+
+thread_pool::thread_pool(unsigned int thread_count)
+: stopping(false) {
+	pthread_mutex_init(&mutex, 0);
+	pthread_cond_init(&task_available, 0);
+	pthread_cond_init(&task_finished, 0);
+
+	if (thread_count == 0)
+		thread_count = default_thread_count();
+
+	// Me quedo con los threads que se pudieron crear; sin
+	// ninguno las tareas nunca se ejecutarían
+	int error = 0;
+	for (unsigned int i = 0; i < thread_count; i++) {
+		pthread_t worker;
+		int result = pthread_create(&worker, 0, &thread_pool::worker_entry, this);
+		if (result == 0)
+			workers.push_back(worker);
+		else
+			error = result;
+	}
+
+	if (workers.empty()) {
+		pthread_cond_destroy(&task_finished);
+		pthread_cond_destroy(&task_available);
+		pthread_mutex_destroy(&mutex);
+		throw std::runtime_error(std::string("Could not create any thread: ") + strerror(error));
+	}
+}
+
+unsigned int thread_pool::get_thread_count() const {
+	return workers.size();
+}
+
+void thread_pool::submit(task *t) {
+	pthread_mutex_lock(&mutex);
+	t->finished = false;
+	t->error.clear();
+	pending.push_back(t);
+	pthread_cond_signal(&task_available);
+	pthread_mutex_unlock(&mutex);
+}
+
+void thread_pool::wait(task *t) {
+	pthread_mutex_lock(&mutex);
+	while (!t->finished)
+		pthread_cond_wait(&task_finished, &mutex);
+	pthread_mutex_unlock(&mutex);
+}
+
+unsigned int thread_pool::default_thread_count() {
+	long processors = sysconf(_SC_NPROCESSORS_ONLN);
+	return processors > 0 ? static_cast<unsigned int>(processors) : 1u;
+}
+
+thread_pool::~thread_pool() {
+	pthread_mutex_lock(&mutex);
+	stopping = true;
+	pthread_cond_broadcast(&task_available);
+	pthread_mutex_unlock(&mutex);
+
+	for (unsigned int i = 0; i < workers.size(); i++) {
+		pthread_join(workers[i], 0);
+	}
+
+	pthread_cond_destroy(&task_finished);
+	pthread_cond_destroy(&task_available);
+	pthread_mutex_destroy(&mutex);
+}
+
+void *thread_pool::worker_entry(void *pool) {
+	static_cast<thread_pool *>(pool)->work();
+	return 0;
+}
+
+void thread_pool::work() {
+	while (true) {
+		pthread_mutex_lock(&mutex);
+		while (pending.empty() && !stopping)
+			pthread_cond_wait(&task_available, &mutex);
+
+		// Al terminar se vacía la cola antes de salir
+		if (pending.empty()) {
+			pthread_mutex_unlock(&mutex);
+			return;
+		}
+
+		task *current = pending.front();
+		pending.pop_front();
+		pthread_mutex_unlock(&mutex);
+
+		// Las excepciones no pueden salir del thread, así que se
+		// guardan en la tarea
+		std::string error;
+		try {
+			current->run();
+		} catch (std::exception &e) {
+			error = e.what();
+			if (error.empty())
+				error = "unknown error";
+		} catch (...) {
+			error = "unknown error";
+		}
+
+		pthread_mutex_lock(&mutex);
+		current->error = error;
+		current->finished = true;
+		pthread_cond_broadcast(&task_finished);
+		pthread_mutex_unlock(&mutex);
+	}
+}
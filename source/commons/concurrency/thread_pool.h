@@ -0,0 +1,109 @@
+/******************************************************************************
+ * thread_pool.h
+ * 		Declaraciones de las clases commons::concurrency::task y
+ * 		commons::concurrency::thread_pool
+******************************************************************************/
+#ifndef __COMMONS_CONCURRENCY_THREAD_POOL_H_INCLUDED__
+#define __COMMONS_CONCURRENCY_THREAD_POOL_H_INCLUDED__
+
+#include <pthread.h>
+#include <deque>
+#include <vector>
+#include <string>
+
+namespace commons {
+namespace concurrency {
+
+class thread_pool;
+
+/**
+ * Interface de una tarea que se ejecuta en un thread_pool
+ */
+class task {
+private:
+	bool finished;
+	std::string error;
+
+	friend class thread_pool;
+public:
+	task();
+
+	/**
+	 * Ejecuta la tarea en alguno de los threads del pool
+	 */
+	virtual void run() = 0;
+
+	/**
+	 * Devuelve true si run elevó una excepción
+	 */
+	bool has_failed() const;
+
+	/**
+	 * Devuelve la descripción de la excepción que elevó run
+	 */
+	const std::string &get_error() const;
+
+	virtual ~task() {}
+};
+
+/**
+ * Conjunto fijo de threads que ejecutan las tareas que se le
+ * encolan, en el orden en que fueron encoladas. El pool no toma
+ * posesión de las tareas: DEBEN sobrevivir hasta que termine su
+ * ejecución.
+ */
+class thread_pool {
+private:
+	std::vector<pthread_t> workers;
+	std::deque<task *> pending;
+	pthread_mutex_t mutex;
+	pthread_cond_t task_available;
+	pthread_cond_t task_finished;
+	bool stopping;
+
+	static void *worker_entry(void *pool);
+	void work();
+
+	thread_pool(const thread_pool &other);
+	thread_pool &operator=(const thread_pool &other);
+public:
+	/**
+	 * Crea un nuevo pool de thread_count threads. Con 0 utiliza
+	 * default_thread_count(). Si el sistema no permite crear todos
+	 * los threads, el pool trabaja con los que se crearon (ver
+	 * get_thread_count); si no se creó ninguno eleva
+	 * std::runtime_error.
+	 */
+	thread_pool(unsigned int thread_count);
+
+	/**
+	 * Devuelve la cantidad de threads del pool
+	 */
+	unsigned int get_thread_count() const;
+
+	/**
+	 * Encola una tarea para que la ejecute el primer thread libre
+	 */
+	void submit(task *t);
+
+	/**
+	 * Espera a que termine de ejecutarse una tarea encolada
+	 */
+	void wait(task *t);
+
+	/**
+	 * Devuelve la cantidad de procesadores disponibles
+	 */
+	static unsigned int default_thread_count();
+
+	/**
+	 * Espera a que se ejecuten todas las tareas encoladas y
+	 * termina los threads
+	 */
+	~thread_pool();
+};
+
+};
+};
+
+#endif
@@ -5,6 +5,8 @@
 #ifndef __COMMONS_IO_BINARY_DESTINATION_H_INCLUDED__
 #define __COMMONS_IO_BINARY_DESTINATION_H_INCLUDED__
 
+#include <stdint.h>
+
 namespace commons {
 namespace io {
 
@@ -18,6 +20,16 @@ public:
 	 */
 	virtual void emit_bit(bool bit) = 0;
 
+	/**
+	 * Emite al destino los count bits menos significativos de
+	 * value, empezando por el más significativo de ellos. count
+	 * DEBE estar entre 0 y 64.
+	 */
+	virtual void emit_bits(uint64_t value, int count) {
+		for (int i = count - 1; i >= 0; i--)
+			emit_bit((value >> i) & 1);
+	}
+
 	virtual ~binary_destination() {}
 };
 
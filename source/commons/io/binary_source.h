@@ -6,6 +6,7 @@
 #define __COMMONS_IO_BINARY_SOURCE_H_INCLUDED__
 
 #include <utility>
+#include <stdint.h>
 
 namespace commons {
 namespace io {
@@ -22,6 +23,22 @@ public:
 	 */
 	virtual std::pair<bool, bool> get_next_bit() = 0;
 
+	/**
+	 * Obtiene los siguientes count bits del origen, con el
+	 * primero como el más significativo. count DEBE estar entre
+	 * 0 y 64. Si el origen se termina antes, pair.first es false
+	 * y los bits que faltaron valen 0.
+	 */
+	virtual std::pair<bool, uint64_t> read_bits(int count) {
+		std::pair<bool, uint64_t> result(true, 0);
+		for (int i = 0; i < count; i++) {
+			std::pair<bool, bool> bit = get_next_bit();
+			result.first = result.first && bit.first;
+			result.second = (result.second << 1) | (bit.first && bit.second ? 1 : 0);
+		}
+		return result;
+	}
+
 	virtual ~binary_source() {}
 };
 
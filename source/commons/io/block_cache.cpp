@@ -0,0 +1,141 @@
+/******************************************************************************
+ * block_cache.cpp
+ * 		Definiciones de la clase commons::io::block_cache
+******************************************************************************/
+#include "block_cache.h"
+#include "../assertions/assertions.h"
+#include <algorithm>
+#include <utility>
+
+using namespace commons::io;
+
+block_cache::block_cache(int block_size, unsigned int capacity, storage &backing)
+: block_size(block_size), capacity(capacity), backing(backing), clock_hand(0), hits(0), misses(0) {
+	ASSERTION(block_size > 0);
+}
+
+void block_cache::read_block_into(int position, block *b) {
+	ASSERTION(b->get_size() == block_size);
+
+	if (capacity == 0) {
+		misses++;
+		backing.load_block(position, b);
+		return;
+	}
+
+	int index = find_frame(position);
+	if (index >= 0) {
+		hits++;
+	} else {
+		misses++;
+		index = acquire_frame(position);
+		try {
+			backing.load_block(position, &frames[index].data);
+		} catch (...) {
+			// Si el frame quedara registrado, la próxima lectura
+			// de la posición devolvería lo que tenía antes
+			discard_frame(index);
+			throw;
+		}
+	}
+
+	frames[index].referenced = true;
+	frames[index].data.copy_to_block(*b);
+}
+
+void block_cache::write_block(int position, const block &b) {
+	ASSERTION(b.get_size() == block_size);
+
+	if (capacity == 0) {
+		backing.store_block(position, b);
+		return;
+	}
+
+	// Como se reemplaza el bloque entero, no hace falta leerlo antes
+	int index = find_frame(position);
+	if (index < 0) {
+		index = acquire_frame(position);
+	}
+
+	frames[index].referenced = true;
+	frames[index].dirty = true;
+	b.copy_to_block(frames[index].data);
+}
+
+void block_cache::flush() {
+	// Escribo en orden de posición para que los accesos
+	// al almacenamiento sean secuenciales
+	std::vector<std::pair<int, int> > dirty_frames;
+	for (unsigned int i = 0; i < frames.size(); i++) {
+		if (frames[i].dirty)
+			dirty_frames.push_back(std::make_pair(frames[i].position, i));
+	}
+	std::sort(dirty_frames.begin(), dirty_frames.end());
+
+	for (unsigned int i = 0; i < dirty_frames.size(); i++) {
+		write_back(frames[dirty_frames[i].second]);
+	}
+}
+
+unsigned int block_cache::get_capacity() const {
+	return capacity;
+}
+
+unsigned int block_cache::get_hits() const {
+	return hits;
+}
+
+unsigned int block_cache::get_misses() const {
+	return misses;
+}
+
+int block_cache::find_frame(int position) const {
+	if (position < static_cast<int>(frame_of_position.size()))
+		return frame_of_position[position];
+	return -1;
+}
+
+int block_cache::acquire_frame(int position) {
+	int index;
+	if (frames.size() < capacity) {
+		// Todavía hay lugar, no hace falta desalojar
+		index = frames.size();
+		frames.push_back(frame(block_size));
+	} else {
+		// Avanzo la aguja del reloj dándole una segunda oportunidad
+		// a los bloques referenciados desde la última vuelta
+		while (frames[clock_hand].referenced) {
+			frames[clock_hand].referenced = false;
+			clock_hand = (clock_hand + 1) % frames.size();
+		}
+		index = clock_hand;
+		clock_hand = (clock_hand + 1) % frames.size();
+
+		write_back(frames[index]);
+		if (frames[index].position >= 0)
+			frame_of_position[frames[index].position] = -1;
+	}
+
+	if (position >= static_cast<int>(frame_of_position.size()))
+		frame_of_position.resize(position + 1, -1);
+	frame_of_position[position] = index;
+	frames[index].position = position;
+	frames[index].referenced = false;
+	frames[index].dirty = false;
+	return index;
+}
+
+void block_cache::discard_frame(int index) {
+	// Sin posición ni referencia, es la próxima víctima del reloj
+	frame_of_position[frames[index].position] = -1;
+	frames[index].position = -1;
+	frames[index].referenced = false;
+	frames[index].dirty = false;
+}
+
+void block_cache::write_back(frame &f) {
+	if (f.dirty) {
+		backing.store_block(f.position, f.data);
+		f.dirty = false;
+	}
+}
@@ -0,0 +1,116 @@
+/******************************************************************************
+ * block_cache.h
+ * 		Declaraciones de la clase commons::io::block_cache
+******************************************************************************/
+#ifndef __COMMONS_IO_BLOCK_CACHE_H_INCLUDED__
+#define __COMMONS_IO_BLOCK_CACHE_H_INCLUDED__
+
+#include "block.h"
+#include <vector>
+
+namespace commons {
+namespace io {
+
+/**
+ * Cache de bloques con política de escritura diferida. Mantiene
+ * hasta capacity bloques en memoria, elige víctimas con el algoritmo
+ * del reloj (CLOCK) y sólo escribe en el almacenamiento los bloques
+ * modificados, cuando son desalojados o cuando se llama a flush.
+ */
+class block_cache {
+public:
+	/**
+	 * Almacenamiento sobre el que trabaja la cache. Es utilizado
+	 * para cargar los bloques que no están en memoria y para
+	 * escribir los bloques modificados.
+	 */
+	struct storage {
+		/**
+		 * Lee el bloque en la posición position desde el
+		 * almacenamiento y lo carga en el bloque b
+		 */
+		virtual void load_block(int position, block *b) = 0;
+
+		/**
+		 * Escribe el bloque b en la posición position del
+		 * almacenamiento
+		 */
+		virtual void store_block(int position, const block &b) = 0;
+
+		virtual ~storage() {};
+	};
+
+private:
+	struct frame {
+		int position;
+		bool dirty;
+		bool referenced;
+		block data;
+
+		frame(int block_size) : position(-1), dirty(false), referenced(false), data(block_size) {}
+	};
+
+	int block_size;
+	unsigned int capacity;
+	storage &backing;
+
+	std::vector<frame> frames;
+	std::vector<int> frame_of_position;
+	unsigned int clock_hand;
+
+	unsigned int hits;
+	unsigned int misses;
+
+	int find_frame(int position) const;
+	int acquire_frame(int position);
+	void discard_frame(int index);
+	void write_back(frame &f);
+public:
+	/**
+	 * Crea una nueva cache de hasta capacity bloques de tamaño
+	 * block_size sobre el almacenamiento backing. Una cache de
+	 * capacidad 0 lee y escribe directamente en el almacenamiento.
+	 */
+	block_cache(int block_size, unsigned int capacity, storage &backing);
+
+	/**
+	 * Carga en b el bloque de la posición position, leyéndolo del
+	 * almacenamiento sólo si no estaba en memoria
+	 */
+	void read_block_into(int position, block *b);
+
+	/**
+	 * Reemplaza el bloque de la posición position por b. El bloque
+	 * queda marcado como modificado hasta que se escriba.
+	 */
+	void write_block(int position, const block &b);
+
+	/**
+	 * Escribe en el almacenamiento todos los bloques modificados,
+	 * en orden de posición
+	 */
+	void flush();
+
+	/**
+	 * Devuelve la cantidad de bloques que se pueden mantener
+	 * en memoria
+	 */
+	unsigned int get_capacity() const;
+
+	/**
+	 * Devuelve la cantidad de lecturas que se resolvieron
+	 * sin ir al almacenamiento
+	 */
+	unsigned int get_hits() const;
+
+	/**
+	 * Devuelve la cantidad de lecturas que tuvieron que ir
+	 * al almacenamiento
+	 */
+	unsigned int get_misses() const;
+};
+
+};
+};
+
+#endif
@@ -3,38 +3,94 @@
  * 		Definiciones de la clase commons::io::block_file
 ******************************************************************************/
 #include "block_file.h"
+#include "ioexception.h"
 #include "../assertions/assertions.h"
+#include <algorithm>
 
 using namespace commons::io;
 using namespace std;
 
-void block_file::initialize_file(const char *filename, int block_size) {
+block_file::file_storage::file_storage(block_file &owner)
+: owner(owner) {
+
+}
+
+void block_file::file_storage::load_block(int position, block *b) {
+	owner.file.seekg(position * owner.block_size);
+	owner.file.read(b->raw_char_pointer(), owner.block_size);
+}
+
+void block_file::file_storage::store_block(int position, const block &b) {
+	owner.file.seekp(position * owner.block_size);
+	owner.file.write(b.raw_char_pointer(), owner.block_size);
+}
+
+void block_file::initialize_file(const char *filename, int block_size, int cache_size, open_mode mode) {
 	ASSERTION(block_size > 0);
 
 	this->block_size = block_size;
-
-	file.open(filename, ios_base::in | ios_base::out | ios_base::binary | ios_base::ate);
-	just_created = !file.is_open();
-	if (just_created) {
-		file.clear();
-		file.open(filename, ios_base::in | ios_base::out | ios_base::binary | ios_base::trunc);
+	this->writable = mode != read_only;
+
+	if (writable) {
+		file.open(filename, ios_base::in | ios_base::out | ios_base::binary | ios_base::ate);
+		just_created = !file.is_open();
+		if (just_created) {
+			file.clear();
+			file.open(filename, ios_base::in | ios_base::out | ios_base::binary | ios_base::trunc);
+		}
+	} else {
+		file.open(filename, ios_base::in | ios_base::binary | ios_base::ate);
+		just_created = false;
+		if (!file.is_open())
+			throw ioexception(string("Could not open '") + filename + "'");
 	}
+
+	// La cantidad de bloques se calcula una sola vez al abrir el
+	// archivo, y se mantiene a medida que se agregan bloques
+	file.seekg(0, ios_base::end);
+	block_count = file.tellg() / block_size;
+
+	// La cache guarda al menos un bloque, aunque sea más grande
+	// que el tamaño pedido
+	unsigned int capacity = cache_size > 0 ? std::max(1, cache_size / block_size) : 0;
+	cache.reset(new block_cache(block_size, capacity, storage));
 }
 
-block_file::block_file(const char *filename, int block_size, const initializer &initializer) {
-	initialize_file(filename, block_size);
+block_file::block_file(const char *filename, int block_size, const initializer &initializer, int cache_size)
+: storage(*this) {
+	initialize_file(filename, block_size, cache_size, read_write);
 	if (just_created)
 		initializer.initialize(this);
 }
 
-block_file::block_file(const char *filename, int block_size) {
-	initialize_file(filename, block_size);
+block_file::block_file(const char *filename, int block_size, int cache_size)
+: storage(*this) {
+	initialize_file(filename, block_size, cache_size, read_write);
+}
+
+block_file::block_file(const char *filename, int block_size, open_mode mode, int cache_size)
+: storage(*this) {
+	initialize_file(filename, block_size, cache_size, mode);
+}
+
+block_file::block_file()
+: block_size(0), block_count(0), just_created(false), writable(true), storage(*this) {
+
 }
 
 void block_file::close() {
+	flush();
 	file.close();
 }
 
+void block_file::flush() {
+	if (!writable)
+		return;
+
+	cache->flush();
+	file.flush();
+}
+
 block block_file::read_block(int position) {
 	block result(block_size);
 	read_block_into(position, &result);
@@ -45,28 +101,29 @@ void block_file::read_block_into(int position, block *b) {
 	ASSERTION(position < get_block_count());
 	ASSERTION(b->get_size() == block_size);
 
-	file.seekg(position * block_size);
-	file.read(b->raw_char_pointer(), block_size);
+	cache->read_block_into(position, b);
 }
 
 void block_file::write_block(int position, const block &b) {
 	ASSERTION(position < get_block_count());
 	ASSERTION(b.get_size() == block_size);
+	ensure_writable();
 
-	file.seekp(position * block_size);
-	file.write(b.raw_char_pointer(), block_size);
+	cache->write_block(position, b);
 }
 
 void block_file::append_block(const block &b) {
 	ASSERTION(b.get_size() == block_size);
+	ensure_writable();
 
-	file.seekp(0, ios_base::end);
-	file.write(b.raw_char_pointer(), block_size);
+	// El bloque nuevo se escribe al final del archivo recién
+	// cuando la cache lo desaloje o se haga flush
+	cache->write_block(block_count, b);
+	block_count++;
 }
 
 int block_file::get_block_count() {
-	file.seekp(0, ios_base::end);
-	return file.tellp() / block_size;
+	return block_count;
 }
 
 int block_file::get_block_size() const {
@@ -77,6 +134,20 @@ bool block_file::is_just_created() const {
 	return just_created;
 }
 
+unsigned int block_file::get_cache_hits() const {
+	return cache.get() ? cache->get_hits() : 0;
+}
+
+unsigned int block_file::get_cache_misses() const {
+	return cache.get() ? cache->get_misses() : 0;
+}
+
 block_file::~block_file() {
+	if (file.is_open())
+		close();
+}
 
+void block_file::ensure_writable() const {
+	if (!writable)
+		throw ioexception("Could not write a block: The file was opened read only");
 }
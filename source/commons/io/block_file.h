@@ -6,7 +6,11 @@
 #define __COMMONS_IO_BLOCK_FILE_H_INCLUDED__
 
 #include "block.h"
+#include "block_cache.h"
+#include "open_mode.h"
+#include "../../config/config.h"
 #include <fstream>
+#include <memory>
 
 namespace commons {
 namespace io {
@@ -16,11 +20,36 @@ namespace io {
  */
 class block_file {
 private:
+	/**
+	 * Adaptador que permite a la cache leer y escribir
+	 * directamente en el archivo
+	 */
+	struct file_storage : public block_cache::storage {
+		block_file &owner;
+
+		file_storage(block_file &owner);
+		virtual void load_block(int position, block *b);
+		virtual void store_block(int position, const block &b);
+	};
+
+	friend struct file_storage;
+
 	int block_size;
+	int block_count;
 	std::fstream file;
 	bool just_created;
+	bool writable;
+	file_storage storage;
+	std::auto_ptr<block_cache> cache;
 
-	void initialize_file(const char *filename, int block_size);
+	void initialize_file(const char *filename, int block_size, int cache_size, open_mode mode);
+	void ensure_writable() const;
+protected:
+	/**
+	 * Constructor para implementaciones alternativas que no
+	 * utilizan el stream ni la cache de block_file
+	 */
+	block_file();
 public:
 	/**
 	 * Comando de inicialización del archivo. Utilizado para
@@ -38,22 +67,39 @@ public:
 	/**
 	 * Crea una nueva instancia de block_file, abriendo el archivo
 	 * dado por filename que contiene bloques de tamaño block_size.
+	 * Mantiene en memoria hasta cache_size bytes de bloques.
 	 */
-	block_file(const char *filename, int block_size);
+	block_file(const char *filename, int block_size, int cache_size = BLOCK_FILE_CACHE_SIZE);
 
 	/**
 	 * Crea una nueva instancia de block_file, abriendo el archivo
 	 * dado por filename que contiene bloques de tamaño block_size.
 	 * Si el archivo no existe, lo crea y llama al initializer para
-	 * que este lo inicialice.
+	 * que este lo inicialice. Mantiene en memoria hasta cache_size
+	 * bytes de bloques.
+	 */
+	block_file(const char *filename, int block_size, const initializer &initializer, int cache_size = BLOCK_FILE_CACHE_SIZE);
+
+	/**
+	 * Crea una nueva instancia de block_file, abriendo el archivo
+	 * dado por filename en el modo dado. En modo read_only el
+	 * archivo tiene que existir y nunca se modifica: escribir o
+	 * agregar bloques eleva ioexception.
 	 */
-	block_file(const char *filename, int block_size, const initializer &initializer);
+	block_file(const char *filename, int block_size, open_mode mode, int cache_size = BLOCK_FILE_CACHE_SIZE);
 
 	/**
-	 * Cierra el archivo.
+	 * Escribe en el archivo todos los bloques modificados que
+	 * estén en la cache y cierra el archivo.
 	 */
 	virtual void close();
 
+	/**
+	 * Escribe en el archivo todos los bloques modificados que
+	 * estén en la cache.
+	 */
+	virtual void flush();
+
 	/**
 	 * Lee el bloque en la posición position y lo devuelve
 	 */
@@ -92,6 +138,22 @@ public:
 	 */
 	virtual bool is_just_created() const;
 
+	/**
+	 * Devuelve la cantidad de lecturas de bloques que se
+	 * resolvieron desde la cache
+	 */
+	unsigned int get_cache_hits() const;
+
+	/**
+	 * Devuelve la cantidad de lecturas de bloques que tuvieron
+	 * que ir al archivo
+	 */
+	unsigned int get_cache_misses() const;
+
+	/**
+	 * Escribe los bloques modificados pendientes y cierra
+	 * el archivo si sigue abierto.
+	 */
 	virtual ~block_file();
 };
 
@@ -0,0 +1,30 @@
+/******************************************************************************
+ * block_file_factory.cpp
+ * 		Definición de funciones que centralizan la creación de archivos de
+ * 		bloques según la configuración de compilación
+******************************************************************************/
+#include "block_file_factory.h"
+#include "mapped_block_file.h"
+#include "../../config/config.h"
+
+using namespace commons::io;
+
+block_file *block_file_factory::open_block_file(const char *filename, int block_size, int cache_size) {
+#if BLOCK_FILE_MAPPED
+	return new mapped_block_file(filename, block_size);
+#else
+	return new block_file(filename, block_size, cache_size);
+#endif
+}
+
+block_file *block_file_factory::open_block_file(const char *filename, int block_size, const block_file::initializer &initializer, int cache_size) {
+#if BLOCK_FILE_MAPPED
+	return new mapped_block_file(filename, block_size, initializer);
+#else
+	return new block_file(filename, block_size, initializer, cache_size);
+#endif
+}
+
+block_file *block_file_factory::open_read_only_block_file(const char *filename, int block_size) {
+	return new mapped_block_file(filename, block_size, read_only);
+}
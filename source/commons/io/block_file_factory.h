@@ -0,0 +1,44 @@
+/******************************************************************************
+ * block_file_factory.h
+ * 		Declaración de funciones que centralizan la creación de archivos de
+ * 		bloques según la configuración de compilación
+******************************************************************************/
+#ifndef __COMMONS_IO_BLOCK_FILE_FACTORY_H_INCLUDED__
+#define __COMMONS_IO_BLOCK_FILE_FACTORY_H_INCLUDED__
+
+#include "block_file.h"
+
+namespace commons {
+namespace io {
+namespace block_file_factory {
+
+/**
+ * Abre un archivo de bloques con la implementación elegida en
+ * BLOCK_FILE_MAPPED. cache_size sólo se utiliza en la implementación
+ * con stream. El archivo se crea en memoria dinámica, es
+ * responsabilidad del que está llamando liberarlo.
+ */
+block_file *open_block_file(const char *filename, int block_size, int cache_size = BLOCK_FILE_CACHE_SIZE);
+
+/**
+ * Abre un archivo de bloques con la implementación elegida en
+ * BLOCK_FILE_MAPPED, inicializándolo con initializer si no existía.
+ * El archivo se crea en memoria dinámica, es responsabilidad del que
+ * está llamando liberarlo.
+ */
+block_file *open_block_file(const char *filename, int block_size, const block_file::initializer &initializer, int cache_size = BLOCK_FILE_CACHE_SIZE);
+
+/**
+ * Abre un archivo de bloques existente sólo para lectura. Sin
+ * importar BLOCK_FILE_MAPPED, el archivo se mapea a memoria, para
+ * que los procesos que lo abren compartan una única copia. El
+ * archivo se crea en memoria dinámica, es responsabilidad del que
+ * está llamando liberarlo.
+ */
+block_file *open_read_only_block_file(const char *filename, int block_size);
+
+};
+};
+};
+
+#endif
@@ -5,6 +5,8 @@
 #ifndef __COMMONS_IO_CHAR_DESTINATION_H_INCLUDED__
 #define __COMMONS_IO_CHAR_DESTINATION_H_INCLUDED__
 
+#include <cstddef>
+
 namespace commons {
 namespace io {
 
@@ -17,6 +19,16 @@ public:
 	 * Emite un char al destino
 	 */
 	virtual void emit_char(unsigned char c) = 0;
+
+	/**
+	 * Emite al destino los size chars de data
+	 */
+	virtual void write(const unsigned char *data, std::size_t size) {
+		for (std::size_t i = 0; i < size; i++)
+			emit_char(data[i]);
+	}
+
+	virtual ~char_destination() {}
 };
 
 };
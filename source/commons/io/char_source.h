@@ -6,6 +6,7 @@
 #define __COMMONS_IO_CHAR_SOURCE_H_INCLUDED__
 
 #include <utility>
+#include <cstddef>
 
 namespace commons {
 namespace io {
@@ -21,6 +22,24 @@ public:
 	 * es el siguiente char. En caso contrario pair.first es false.
 	 */
 	virtual std::pair<bool, unsigned char> get_next_char() = 0;
+
+	/**
+	 * Copia en buffer los siguientes chars del origen, hasta
+	 * size. Devuelve la cantidad de chars copiados, que sólo es
+	 * 0 si el origen se terminó.
+	 */
+	virtual std::size_t read(unsigned char *buffer, std::size_t size) {
+		std::size_t count = 0;
+		for (; count < size; count++) {
+			std::pair<bool, unsigned char> next = get_next_char();
+			if (!next.first)
+				break;
+			buffer[count] = next.second;
+		}
+		return count;
+	}
+
+	virtual ~char_source() {}
 };
 
 };
@@ -7,6 +7,9 @@
 #include <algorithm>
 #include <sstream>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
 #include <dirent.h>
 #include <sys/stat.h>
 
@@ -17,8 +20,9 @@ using namespace commons::io;
 directory::directory(const string &path)
 : path(path) {
 	DIR *dir = opendir( path.c_str() );
-	closedir(dir);
-	if (dir == NULL){
+	if (dir != NULL) {
+		closedir(dir);
+	} else {
 		// creo el directorio
 		if (mkdir( path.c_str(), 0777) == -1){
 			stringstream error_description;
@@ -77,3 +81,20 @@ void directory::remove() {
 		throw ioexception(error_description.str());
 	}
 }
+
+string directory::create_temporary(const string &prefix) {
+	const char *temporary_path = getenv("TMPDIR");
+	string path_template = string(temporary_path && *temporary_path ? temporary_path : "/tmp") + "/" + prefix + ".XXXXXX";
+
+	// mkdtemp reemplaza las X del template con el nombre elegido
+	vector<char> path(path_template.begin(), path_template.end());
+	path.push_back('\0');
+	if (mkdtemp(&path[0]) == NULL) {
+		stringstream error_description;
+		error_description
+			<< "Could not create a temporary directory '" << path_template
+			<< "': " << strerror(errno);
+		throw ioexception(error_description.str());
+	}
+	return string(&path[0]);
+}
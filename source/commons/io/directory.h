@@ -47,6 +47,14 @@ public:
 	 * Elimina el directorio y todos sus archivos
 	 */
 	void remove();
+
+	/**
+	 * Crea un directorio nuevo, con un nombre único que empieza
+	 * con prefix, en el directorio temporal del sistema ($TMPDIR o
+	 * /tmp), y devuelve su path. Si no puede crearlo eleva
+	 * ioexception.
+	 */
+	static std::string create_temporary(const std::string &prefix);
 };
 
 };
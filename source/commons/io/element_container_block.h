@@ -10,6 +10,7 @@
 #include "serializators.h"
 #include <utility>
 #include <stdexcept>
+#include <cstring>
 
 namespace commons {
 namespace io {
@@ -17,11 +18,40 @@ namespace io {
 /**
  * Representa un bloque que contiene elementos  de
  * tamaño variable de tipo T.
+ *
+ * El bloque se organiza como una página con directorio:
+ *
+ * [metadata][free index][cantidad][registros ->  libre  <- directorio]
+ *
+ * Los registros (clave serializada seguida del valor) se escriben
+ * uno detrás del otro a partir de get_element_start_index(), en el
+ * orden en que se agregan. Al final del bloque hay un directorio
+ * con la posición de cada registro, ordenado por clave, que permite
+ * buscar un elemento con una búsqueda binaria y recorrer los
+ * elementos en orden.
  */
 template<typename K, typename T>
 class element_container_block {
 private:
 	block inner_block;
+
+	void set_element_count(int count);
+	int get_slot_index(int slot) const;
+	void set_element_position(int slot, int position);
+	void insert_slot(int slot, int position);
+	void remove_slot(int slot);
+	void move_records(int from, int delta);
+
+	/**
+	 * Busca la clave key en el directorio. Si la clave existe,
+	 * result.first será true y result.second será su número de
+	 * entrada. En caso contrario result.first será false y
+	 * result.second será la entrada en la que debería insertarse.
+	 */
+	std::pair<bool, int> find_slot(const K &key) const;
+
+	void insert_element(int slot, const K &key, const T &value);
+	void replace_element(int element_position, const K &key, const T &value);
 protected:
 	/**
 	 * Obtiene el bloque interno sobre el que trabaja
@@ -78,15 +108,33 @@ protected:
 	int get_next_element_index(int current_position) const;
 
 	/**
-	 * Obtiene la longitud de los metadatos.
+	 * Obtiene la cantidad de elementos del contenedor
 	 */
-	virtual int get_metadata_length() const = 0;
+	int get_element_count() const;
+
+	/**
+	 * Obtiene la posición en donde inicia el elemento
+	 * número slot, en el orden de las claves
+	 */
+	int get_element_position(int slot) const;
 
 	/**
-	 * Hace espacio para un elemento element y devuelve
-	 * la posición en la que debe escribirse el elemento.
+	 * Obtiene la cantidad de bytes que ocupa el directorio
+	 * de elementos al final del bloque
 	 */
-	virtual int make_room_for_element(const K &key, const T &value) = 0;
+	int get_directory_length() const;
+
+	/**
+	 * Copia los elementos y metadatos de este contenedor en
+	 * other, cuyo bloque puede ser de otro tamaño siempre que
+	 * alcance para todos los elementos.
+	 */
+	void copy_to_container(element_container_block &other) const;
+
+	/**
+	 * Obtiene la longitud de los metadatos.
+	 */
+	virtual int get_metadata_length() const = 0;
 
 	/**
 	 * Maneja un overflow al agregar un elemento.
@@ -99,20 +147,21 @@ protected:
 	virtual void handle_modification_overflow(const K &key, const T &value, int total_required_size) = 0;
 public:
 	/**
-	 * Iterador a los elementos del contenedor
+	 * Iterador a los elementos del contenedor, en el
+	 * orden de sus claves
 	 */
 	class iterator;
 	friend class iterator;
 	class iterator {
 	private:
 		const element_container_block &container;
-		int current_position;
+		int current_slot;
 	public:
 		/**
 		 * Crea una nueva instancia de iterator apuntando
-		 * a un bloque block
+		 * al elemento número start_slot de un contenedor
 		 */
-		iterator(const element_container_block &container, int start_position);
+		iterator(const element_container_block &container, int start_slot);
 
 		/**
 		 * Mueve el iterador al siguiente elemento de la secuencia
@@ -165,12 +214,12 @@ public:
 	/**
 	 * Obtiene un iterador al primer elemento del contenedor
 	 */
-	iterator begin() const { return iterator(*this, get_element_start_index()); }
+	iterator begin() const { return iterator(*this, 0); }
 
 	/**
 	 * Obtiene un iterador al último elemento
 	 */
-	iterator end() const { return iterator(*this, get_free_index()); }
+	iterator end() const { return iterator(*this, get_element_count()); }
 
 	/**
 	 * Agrega un elemento a este contenedor.
@@ -189,6 +238,12 @@ public:
 	 */
 	virtual void update_element(const K &key, const T &value);
 
+	/**
+	 * Actualiza los datos de un elemento dado si existe, o
+	 * lo agrega en caso contrario, buscándolo una única vez.
+	 */
+	virtual void upsert_element(const K &key, const T &value);
+
 	/**
 	 * Elimina un elemento dada su clave key.
 	 */
@@ -215,18 +270,20 @@ public:
 
 
 template<typename K, typename T>
-element_container_block<K, T>::iterator::iterator(const element_container_block &container, int start_position)
-: container(container), current_position(start_position) {
+element_container_block<K, T>::iterator::iterator(const element_container_block &container, int start_slot)
+: container(container), current_slot(start_slot) {
 
 }
 
 template<typename K, typename T>
 void element_container_block<K, T>::iterator::operator++(int) {
-	current_position = container.get_next_element_index(current_position);
+	current_slot++;
 }
 
 template<typename K, typename T>
 std::pair<K, T> element_container_block<K, T>::iterator::operator*() const {
+	int current_position = container.get_element_position(current_slot);
+
 	// Levanto la clave saltando la longitud del registro
 	K key = commons::io::deserialize<K>(container.inner_block, current_position);
 
@@ -241,12 +298,12 @@ std::pair<K, T> element_container_block<K, T>::iterator::operator*() const {
 
 template<typename K, typename T>
 bool element_container_block<K, T>::iterator::operator==(const element_container_block<K, T>::iterator &other) const {
-	return current_position == other.current_position;
+	return current_slot == other.current_slot;
 }
 
 template<typename K, typename T>
 bool element_container_block<K, T>::iterator::operator!=(const element_container_block<K, T>::iterator &other) const {
-	return current_position != other.current_position;
+	return current_slot != other.current_slot;
 }
 
 template<typename K, typename T>
@@ -257,38 +314,20 @@ element_container_block<K, T>::element_container_block(const commons::io::block
 
 template<typename K, typename T>
 void element_container_block<K, T>::clear_elements() {
-	// Inicializo el control de espacio libre
+	// Inicializo el control de espacio libre y el directorio
 	set_free_index(get_element_start_index());
+	set_element_count(0);
 }
 
 template<typename K, typename T>
 void element_container_block<K, T>::add_element(const K &key, const T &value) {
-	// Chequeamos si agregar el elemento causaría un overflow
-	int totalRecordLength =
-			commons::io::serialization_length(key) +
-			commons::io::serialization_length(value);
-
-	if (get_free_index() + totalRecordLength > inner_block.get_size()) {
-		handle_insertion_overflow(key, value, get_free_index() + totalRecordLength);
-	}
-
 	// Chequeamos si el elemento ya existe
-	if (0 <= get_element_index(key)) {
+	std::pair<bool, int> slot = find_slot(key);
+	if (slot.first) {
 		throw duplicate_exception();
 	}
 
-	// Obtengo la posición en donde tengo que escribir el elemento
-	int current_field_position = make_room_for_element(key, value);
-
-	// Primero escribo la clave del registro
-	commons::io::serialize(key, &inner_block, current_field_position);
-	current_field_position += commons::io::serialization_length(key);
-
-	// Por último escribo los datos del registro
-	commons::io::serialize(value, &inner_block, current_field_position);
-
-	// Calculo la nueva última posición libre y actualizo
-	increase_free_index(totalRecordLength);
+	insert_element(slot.second, key, value);
 }
 
 template<typename K, typename T>
@@ -315,63 +354,43 @@ void element_container_block<K, T>::update_element(const K &key, const T &value)
 		throw not_found_exception();
 	}
 
-	// Calculo la posición de los datos del registro
-	int data_position =
-			element_position + commons::io::serialization_length(key);
-
-	// Ahora comparo con la nueva longitud del registro.
-	int length_delta =
-			commons::io::serialization_length(value) -
-			commons::io::serialization_length<T>(inner_block, data_position);
+	replace_element(element_position, key, value);
+}
 
-	if (length_delta > 0) {
-		// Tenemos que hacer espacio para más datos. Puede ser
-		// que haya overflow
-		if (length_delta + get_free_index() > inner_block.get_size()) {
-			handle_modification_overflow(key, value, length_delta + get_free_index());
-		}
-		// Si es menor tengo que hacer espacio para los nuevos datos
-		inner_block.make_gap(data_position, length_delta);
-		// Actualizo la posición libre que ahora está más lejos
-		set_free_index(get_free_index() + length_delta);
-	} else if (length_delta < 0) {
-		// Si es mayor tengo que quitar lo que sobra
-		inner_block.erase_and_compact(data_position, data_position - length_delta - 1);
-		// Actualizo la posición libre que ahora está más cerca (length_delta es negativo)
-		set_free_index(get_free_index() + length_delta);
+template<typename K, typename T>
+void element_container_block<K, T>::upsert_element(const K &key, const T &value) {
+	std::pair<bool, int> slot = find_slot(key);
+	if (slot.first) {
+		replace_element(get_element_position(slot.second), key, value);
+	} else {
+		insert_element(slot.second, key, value);
 	}
-
-	// Ahora que hay espacio serializo los datos
-	commons::io::serialize(value, &inner_block, data_position);
 }
 
 template<typename K, typename T>
 void element_container_block<K, T>::remove_element(const K &key) {
-	// Obtengo la posición del elemento que estoy buscando
-	int element_position = get_element_index(key);
+	// Busco la entrada del elemento en el directorio
+	std::pair<bool, int> slot = find_slot(key);
 
 	// Si no existe... estamos en el horno
-	if (element_position < 0) {
+	if (!slot.first) {
 		throw not_found_exception();
 	}
 
 	// El tamaño total de bytes que hay que volar es
 	// el tamaño de la clave mas el tamaño del elemento
-	int key_length = commons::io::serialization_length<K>(inner_block, element_position);
-	int value_length = commons::io::serialization_length<T>(inner_block, element_position + key_length);
-	int total_length = key_length + value_length;
+	int element_position = get_element_position(slot.second);
+	int total_length = get_next_element_index(element_position) - element_position;
 
-	// Y ahora comprimo los datos eliminando lo que
-	// está en la posición del elemento
-	inner_block.erase_and_compact(element_position, element_position + total_length - 1);
-
-	// Por último actualizo la posición disponible
-	set_free_index(get_free_index() - total_length);
+	// Saco la entrada del directorio y compacto los
+	// registros que están después del eliminado
+	remove_slot(slot.second);
+	move_records(element_position + total_length, -total_length);
 }
 
 template<typename K, typename T>
 bool element_container_block<K, T>::is_empty() const {
-	return get_free_index() == get_element_start_index();
+	return get_element_count() == 0;
 }
 
 template<typename K, typename T>
@@ -411,29 +430,13 @@ int element_container_block<K, T>::get_free_index() const {
 
 template<typename K, typename T>
 int element_container_block<K, T>::get_element_index(const K &key) const {
-	// Me paro en la primer posición que puede tener un elemento
-	int current_position = get_element_start_index();
-
-	// Mientras la posición actual no sea la primer posición disponible
-	while (current_position != get_free_index()) {
-		// Me paro en la posición actual, que es la posición del primer campo
-		// del registro
-		int current_field = current_position;
-
-		// Obtengo la clave del registro y avanzo al siguiente campo
-		K record_key = commons::io::deserialize<K>(inner_block, current_field);
-		current_field += commons::io::serialization_length(record_key);
-
-		if (record_key == key) {
-			return current_position;
-		} else {
-			current_position =
-					current_field +
-					commons::io::serialization_length<T>(inner_block, current_field);
-		}
+	std::pair<bool, int> slot = find_slot(key);
+	if (slot.first) {
+		return get_element_position(slot.second);
+	} else {
+		// El registro no se encontró.
+		return -1;
 	}
-	// El registro no se encontró.
-	return -1;
 }
 
 template<typename K, typename T>
@@ -450,7 +453,167 @@ int element_container_block<K, T>::get_next_element_index(int current_position)
 
 template<typename K, typename T>
 int element_container_block<K, T>::get_element_start_index() const {
-	return sizeof(int) + get_metadata_length();
+	return
+		sizeof(int) + // Free index
+		sizeof(int) + // Cantidad de elementos
+		get_metadata_length();
+}
+
+template<typename K, typename T>
+int element_container_block<K, T>::get_element_count() const {
+	return commons::io::deserialize<int>(inner_block, get_metadata_length() + sizeof(int));
+}
+
+template<typename K, typename T>
+void element_container_block<K, T>::set_element_count(int count) {
+	commons::io::serialize(count, &inner_block, static_cast<int>(get_metadata_length() + sizeof(int)));
+}
+
+template<typename K, typename T>
+int element_container_block<K, T>::get_directory_length() const {
+	return get_element_count() * sizeof(int);
+}
+
+template<typename K, typename T>
+int element_container_block<K, T>::get_slot_index(int slot) const {
+	// Las entradas están al final del bloque, la entrada 0
+	// es la primera de ellas
+	return inner_block.get_size() - get_directory_length() + slot * sizeof(int);
+}
+
+template<typename K, typename T>
+int element_container_block<K, T>::get_element_position(int slot) const {
+	return commons::io::deserialize<int>(inner_block, get_slot_index(slot));
+}
+
+template<typename K, typename T>
+void element_container_block<K, T>::set_element_position(int slot, int position) {
+	commons::io::serialize(position, &inner_block, get_slot_index(slot));
+}
+
+template<typename K, typename T>
+void element_container_block<K, T>::insert_slot(int slot, int position) {
+	// El directorio crece hacia el principio del bloque, así que
+	// las entradas anteriores a slot se corren una posición
+	char *directory = inner_block.raw_char_pointer() + get_slot_index(0);
+	std::memmove(directory - sizeof(int), directory, slot * sizeof(int));
+	set_element_count(get_element_count() + 1);
+	set_element_position(slot, position);
+}
+
+template<typename K, typename T>
+void element_container_block<K, T>::remove_slot(int slot) {
+	char *directory = inner_block.raw_char_pointer() + get_slot_index(0);
+	std::memmove(directory + sizeof(int), directory, slot * sizeof(int));
+	set_element_count(get_element_count() - 1);
+}
+
+template<typename K, typename T>
+void element_container_block<K, T>::move_records(int from, int delta) {
+	// Corro los bytes de los registros que empiezan en from
+	char *records = inner_block.raw_char_pointer();
+	std::memmove(records + from + delta, records + from, get_free_index() - from);
+	increase_free_index(delta);
+
+	// Actualizo las entradas de los registros corridos
+	for (int slot = 0; slot < get_element_count(); slot++) {
+		int position = get_element_position(slot);
+		if (position >= from) {
+			set_element_position(slot, position + delta);
+		}
+	}
+}
+
+template<typename K, typename T>
+std::pair<bool, int> element_container_block<K, T>::find_slot(const K &key) const {
+	// Búsqueda binaria sobre el directorio ordenado, comparando
+	// contra las claves serializadas sin deserializarlas
+	int lower = 0;
+	int upper = get_element_count();
+	while (lower < upper) {
+		int middle = lower + (upper - lower) / 2;
+		int comparison = commons::io::compare_serialized(key, inner_block, get_element_position(middle));
+
+		if (comparison > 0) {
+			lower = middle + 1;
+		} else if (comparison < 0) {
+			upper = middle;
+		} else {
+			return std::make_pair(true, middle);
+		}
+	}
+	return std::make_pair(false, lower);
+}
+
+template<typename K, typename T>
+void element_container_block<K, T>::insert_element(int slot, const K &key, const T &value) {
+	// Chequeamos si agregar el elemento causaría un overflow,
+	// contando la nueva entrada del directorio
+	int totalRecordLength =
+			commons::io::serialization_length(key) +
+			commons::io::serialization_length(value);
+	int required_size = get_free_index() + totalRecordLength + get_directory_length() + sizeof(int);
+
+	if (required_size > inner_block.get_size()) {
+		handle_insertion_overflow(key, value, required_size);
+	}
+
+	// El registro siempre se escribe al final de los registros
+	int current_field_position = get_free_index();
+	insert_slot(slot, current_field_position);
+
+	// Primero escribo la clave del registro
+	commons::io::serialize(key, &inner_block, current_field_position);
+	current_field_position += commons::io::serialization_length(key);
+
+	// Por último escribo los datos del registro
+	commons::io::serialize(value, &inner_block, current_field_position);
+
+	// Calculo la nueva última posición libre y actualizo
+	increase_free_index(totalRecordLength);
+}
+
+template<typename K, typename T>
+void element_container_block<K, T>::replace_element(int element_position, const K &key, const T &value) {
+	// Calculo la posición de los datos del registro
+	int data_position =
+			element_position + commons::io::serialization_length(key);
+
+	// Ahora comparo con la nueva longitud del registro.
+	int old_value_length = commons::io::serialization_length<T>(inner_block, data_position);
+	int length_delta = commons::io::serialization_length(value) - old_value_length;
+
+	if (length_delta > 0) {
+		// Tenemos que hacer espacio para más datos. Puede ser
+		// que haya overflow
+		int required_size = length_delta + get_free_index() + get_directory_length();
+		if (required_size > inner_block.get_size()) {
+			handle_modification_overflow(key, value, required_size);
+		}
+	}
+
+	if (length_delta != 0) {
+		// Corro los registros que están después de este
+		move_records(data_position + old_value_length, length_delta);
+	}
+
+	// Ahora que hay espacio serializo los datos
+	commons::io::serialize(value, &inner_block, data_position);
+}
+
+template<typename K, typename T>
+void element_container_block<K, T>::copy_to_container(element_container_block &other) const {
+	// Copio metadatos y registros tal como están
+	std::memcpy(
+		other.inner_block.raw_char_pointer(),
+		inner_block.raw_char_pointer(),
+		get_free_index());
+
+	// El directorio va al final del otro bloque
+	std::memcpy(
+		other.inner_block.raw_char_pointer() + other.inner_block.get_size() - get_directory_length(),
+		inner_block.raw_char_pointer() + get_slot_index(0),
+		get_directory_length());
 }
 
 };
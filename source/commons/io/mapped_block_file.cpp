@@ -0,0 +1,211 @@
+/******************************************************************************
+ * mapped_block_file.cpp
+ * 		Definiciones de la clase commons::io::mapped_block_file
+******************************************************************************/
+#include "mapped_block_file.h"
+#include "ioexception.h"
+#include "../assertions/assertions.h"
+#include <sstream>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace commons::io;
+using namespace std;
+
+namespace {
+
+void throw_error(const char *operation, const char *filename) {
+	stringstream error_description;
+	error_description
+		<< "Could not " << operation << " '" << (filename ? filename : "mapped block file")
+		<< "': " << strerror(errno);
+	throw ioexception(error_description.str());
+}
+
+};
+
+void mapped_block_file::initialize_mapping(const char *filename, int block_size, open_mode mode) {
+	ASSERTION(block_size > 0);
+
+	this->block_size = block_size;
+	this->mapping = 0;
+	this->mapped_size = 0;
+	this->writable = mode != read_only;
+
+	descriptor = ::open(filename, writable ? O_RDWR : O_RDONLY);
+	just_created = descriptor < 0 && writable;
+	if (just_created) {
+		descriptor = ::open(filename, O_RDWR | O_CREAT | O_TRUNC, 0666);
+	}
+	if (descriptor < 0)
+		throw_error("open", filename);
+
+	struct stat file_status;
+	if (fstat(descriptor, &file_status) < 0)
+		throw_error("stat", filename);
+	block_count = file_status.st_size / block_size;
+	file_size = file_status.st_size;
+
+	if (writable) {
+		ensure_mapped(static_cast<size_t>(block_count) * block_size);
+	} else {
+		// Sin escritura el archivo no se puede agrandar, así que
+		// se mapea tal como está
+		if (block_count == 0) {
+			::close(descriptor);
+			descriptor = -1;
+			throw ioexception(string("Could not map '") + filename + "': The file has no blocks");
+		}
+		map(static_cast<size_t>(block_count) * block_size);
+	}
+}
+
+mapped_block_file::mapped_block_file(const char *filename, int block_size) {
+	initialize_mapping(filename, block_size, read_write);
+}
+
+mapped_block_file::mapped_block_file(const char *filename, int block_size, const initializer &initializer) {
+	initialize_mapping(filename, block_size, read_write);
+	if (just_created)
+		initializer.initialize(this);
+}
+
+mapped_block_file::mapped_block_file(const char *filename, int block_size, open_mode mode) {
+	initialize_mapping(filename, block_size, mode);
+}
+
+void mapped_block_file::close() {
+	if (descriptor < 0)
+		return;
+
+	if (!writable) {
+		unmap();
+		::close(descriptor);
+		descriptor = -1;
+		return;
+	}
+
+	// Aunque falle la sincronización o el recorte el archivo
+	// queda cerrado
+	try {
+		flush();
+		unmap();
+
+		size_t blocks_size = static_cast<size_t>(block_count) * block_size;
+		if (file_size != blocks_size && ftruncate(descriptor, static_cast<off_t>(blocks_size)) < 0)
+			throw_error("truncate", 0);
+	} catch (ioexception &e) {
+		unmap();
+		::close(descriptor);
+		descriptor = -1;
+		throw;
+	}
+	::close(descriptor);
+	descriptor = -1;
+}
+
+void mapped_block_file::flush() {
+	if (writable && mapping != 0 && msync(mapping, mapped_size, MS_SYNC) < 0)
+		throw_error("sync", 0);
+}
+
+block mapped_block_file::read_block(int position) {
+	return block(block_size, view_block(position));
+}
+
+void mapped_block_file::read_block_into(int position, block *b) {
+	ASSERTION(b->get_size() == block_size);
+
+	memcpy(b->raw_char_pointer(), view_block(position), block_size);
+}
+
+void mapped_block_file::write_block(int position, const block &b) {
+	ASSERTION(b.get_size() == block_size);
+	ensure_writable();
+
+	memcpy(view_block(position), b.raw_char_pointer(), block_size);
+}
+
+void mapped_block_file::append_block(const block &b) {
+	ASSERTION(b.get_size() == block_size);
+	ensure_writable();
+
+	// El archivo crece junto con el mapeo, de a extents enteros,
+	// para no agrandarlo en cada bloque; close lo recorta
+	size_t new_size = static_cast<size_t>(block_count + 1) * block_size;
+	ensure_mapped(new_size);
+	if (file_size < new_size) {
+		if (ftruncate(descriptor, static_cast<off_t>(mapped_size)) < 0)
+			throw_error("grow", 0);
+		file_size = mapped_size;
+	}
+	block_count++;
+	write_block(block_count - 1, b);
+}
+
+char *mapped_block_file::view_block(int position) {
+	ASSERTION(position >= 0 && position < block_count);
+
+	return mapping + static_cast<size_t>(position) * block_size;
+}
+
+int mapped_block_file::get_block_count() {
+	return block_count;
+}
+
+int mapped_block_file::get_block_size() const {
+	return block_size;
+}
+
+bool mapped_block_file::is_just_created() const {
+	return just_created;
+}
+
+mapped_block_file::~mapped_block_file() {
+	try {
+		close();
+	} catch (ioexception &e) {
+		// Un destructor no puede elevar excepciones; quien necesite
+		// saber si se sincronizó el archivo tiene que llamar a close
+	}
+}
+
+void mapped_block_file::ensure_mapped(size_t size) {
+	if (size <= mapped_size && mapping != 0)
+		return;
+
+	// Mapeo de a extents enteros para no remapear en cada append.
+	// Hasta el próximo append el mapeo puede pasarse del final del
+	// archivo: sólo se accede a los bloques que ya existen
+	size_t extents = (size + BLOCK_FILE_MAPPED_EXTENT_SIZE - 1) / BLOCK_FILE_MAPPED_EXTENT_SIZE;
+	size_t new_size = (extents > 0 ? extents : 1) * BLOCK_FILE_MAPPED_EXTENT_SIZE;
+
+	unmap();
+	map(new_size);
+}
+
+void mapped_block_file::map(size_t size) {
+	void *result = mmap(0, size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, descriptor, 0);
+	if (result == MAP_FAILED)
+		throw_error("map", 0);
+
+	mapping = static_cast<char *>(result);
+	mapped_size = size;
+}
+
+void mapped_block_file::unmap() {
+	if (mapping != 0) {
+		munmap(mapping, mapped_size);
+		mapping = 0;
+		mapped_size = 0;
+	}
+}
+
+void mapped_block_file::ensure_writable() const {
+	if (!writable)
+		throw ioexception("Could not write a block: The file was opened read only");
+}
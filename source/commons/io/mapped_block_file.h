@@ -0,0 +1,135 @@
+/******************************************************************************
+ * mapped_block_file.h
+ * 		Declaraciones de la clase commons::io::mapped_block_file
+******************************************************************************/
+#ifndef __COMMONS_IO_MAPPED_BLOCK_FILE_H_INCLUDED__
+#define __COMMONS_IO_MAPPED_BLOCK_FILE_H_INCLUDED__
+
+#include "block_file.h"
+#include <cstddef>
+
+namespace commons {
+namespace io {
+
+/**
+ * Implementación de block_file que mapea el archivo a memoria.
+ * Los bloques se leen y escriben directamente sobre el mapeo, sin
+ * pasar por un stream ni por una cache, pero se siguen copiando:
+ * los contenedores arman sus nodos sobre bloques propios.
+ *
+ * El mapeo y el archivo crecen de a extents de tamaño fijo, y al
+ * cerrarlo el archivo se recorta a lo que ocupan sus bloques. Si
+ * el proceso termina sin cerrarlo, al final quedan bloques en cero
+ * hasta completar el extent, que al reabrirlo se cuentan como
+ * bloques del archivo.
+ *
+ * Abierto en modo read_only el archivo se mapea sólo para lectura,
+ * así que todos los procesos que lo abren comparten las mismas
+ * páginas en memoria; cualquier escritura eleva ioexception.
+ */
+class mapped_block_file : public block_file {
+private:
+	int descriptor;
+	char *mapping;
+	std::size_t mapped_size;
+	int block_size;
+	int block_count;
+	std::size_t file_size;
+	bool just_created;
+	bool writable;
+
+	void initialize_mapping(const char *filename, int block_size, open_mode mode);
+	void ensure_writable() const;
+	void ensure_mapped(std::size_t size);
+	void map(std::size_t size);
+	void unmap();
+
+	// Dirección del bloque en la posición position dentro del mapeo.
+	// Deja de ser válida al agregar bloques o cerrar
+	char *view_block(int position);
+public:
+	/**
+	 * Crea una nueva instancia de mapped_block_file, abriendo el
+	 * archivo dado por filename que contiene bloques de tamaño
+	 * block_size.
+	 */
+	mapped_block_file(const char *filename, int block_size);
+
+	/**
+	 * Crea una nueva instancia de mapped_block_file, abriendo el
+	 * archivo dado por filename que contiene bloques de tamaño
+	 * block_size. Si el archivo no existe, lo crea y llama al
+	 * initializer para que este lo inicialice.
+	 */
+	mapped_block_file(const char *filename, int block_size, const initializer &initializer);
+
+	/**
+	 * Crea una nueva instancia de mapped_block_file, abriendo el
+	 * archivo dado por filename en el modo dado. En modo read_only
+	 * el archivo tiene que existir y no estar vacío.
+	 */
+	mapped_block_file(const char *filename, int block_size, open_mode mode);
+
+	/**
+	 * Sincroniza el mapeo con el disco, lo libera, recorta el
+	 * archivo a lo que ocupan sus bloques y lo cierra. Si falla la
+	 * sincronización o el recorte eleva ioexception, pero el archivo
+	 * queda cerrado igual.
+	 */
+	virtual void close();
+
+	/**
+	 * Sincroniza con el disco los bloques modificados (msync).
+	 */
+	virtual void flush();
+
+	/**
+	 * Lee el bloque en la posición position y lo devuelve
+	 */
+	virtual block read_block(int position);
+
+	/**
+	 * Lee el bloque en la posición position y lo carga en
+	 * el bloque b
+	 */
+	virtual void read_block_into(int position, block *b);
+
+	/**
+	 * Sobreescribe lo que haya en el bloque en la posición
+	 * position con los contenidos del bloque b
+	 */
+	virtual void write_block(int position, const block &b);
+
+	/**
+	 * Agrega un bloque al final del archivo, agrandando el
+	 * mapeo y el archivo en un extent si hace falta
+	 */
+	virtual void append_block(const block &b);
+
+	/**
+	 * Devuelve la cantidad de bloques que hay en el archivo
+	 */
+	virtual int get_block_count();
+
+	/**
+	 * Devuelve el tamaño de bloque del archivo
+	 */
+	virtual int get_block_size() const;
+
+	/**
+	 * Devuelve true si el mapped_block_file se creo porque
+	 * no existía el archivo.
+	 */
+	virtual bool is_just_created() const;
+
+	/**
+	 * Cierra el archivo si sigue abierto, descartando los errores
+	 * de sincronización.
+	 */
+	virtual ~mapped_block_file();
+};
+
+};
+};
+
+#endif
@@ -0,0 +1,103 @@
+/******************************************************************************
+ * mapped_char_source.cpp
+ * 		Definiciones de la clase commons::io::mapped_char_source
+******************************************************************************/
+#include "mapped_char_source.h"
+#include "ioexception.h"
+#include "../../config/config.h"
+#include <sstream>
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace commons::io;
+using namespace std;
+
+namespace {
+
+void throw_error(const char *operation, const char *filename) {
+	stringstream error_description;
+	error_description
+		<< "Could not " << operation << " '" << filename
+		<< "': " << strerror(errno);
+	throw ioexception(error_description.str());
+}
+
+};
+
+mapped_char_source::mapped_char_source(const char *filename)
+: filename(filename), descriptor(-1), mapping(0), size(0), position(0), exhausted(false) {
+	descriptor = ::open(filename, O_RDONLY);
+	if (descriptor < 0)
+		throw_error("open", filename);
+
+	struct stat file_status;
+	if (fstat(descriptor, &file_status) < 0) {
+		::close(descriptor);
+		throw_error("stat", filename);
+	}
+
+	// Un archivo vacío no se puede mapear, y un FIFO tampoco: en
+	// esos casos se lee del descriptor
+	if (S_ISREG(file_status.st_mode) && file_status.st_size > 0) {
+		size = file_status.st_size;
+		void *result = mmap(0, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+		if (result == MAP_FAILED) {
+			::close(descriptor);
+			throw_error("map", filename);
+		}
+		mapping = static_cast<const unsigned char *>(result);
+		madvise(result, size, MADV_SEQUENTIAL);
+	}
+}
+
+std::pair<bool, unsigned char> mapped_char_source::get_next_char() {
+	if (position >= size && (mapping != 0 || !fill_buffer()))
+		return std::make_pair(false, static_cast<unsigned char>(0));
+
+	const unsigned char *chars = mapping != 0 ? mapping : &buffer[0];
+	return std::make_pair(true, chars[position++]);
+}
+
+std::size_t mapped_char_source::read(unsigned char *buffer, std::size_t size) {
+	std::size_t total = 0;
+	while (total < size) {
+		if (position >= this->size && (mapping != 0 || !fill_buffer()))
+			break;
+
+		const unsigned char *chars = mapping != 0 ? mapping : &this->buffer[0];
+		std::size_t count = std::min(size - total, this->size - position);
+		std::memcpy(buffer + total, chars + position, count);
+		position += count;
+		total += count;
+	}
+	return total;
+}
+
+bool mapped_char_source::fill_buffer() {
+	if (exhausted)
+		return false;
+
+	buffer.resize(CHAR_STREAM_BUFFER_SIZE);
+	ssize_t count;
+	do {
+		count = ::read(descriptor, &buffer[0], buffer.size());
+	} while (count < 0 && errno == EINTR);
+	if (count < 0)
+		throw_error("read", filename.c_str());
+
+	exhausted = count == 0;
+	size = count;
+	position = 0;
+	return !exhausted;
+}
+
+mapped_char_source::~mapped_char_source() {
+	if (mapping != 0)
+		munmap(const_cast<unsigned char *>(mapping), size);
+	::close(descriptor);
+}
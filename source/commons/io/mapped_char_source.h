@@ -0,0 +1,68 @@
+/******************************************************************************
+ * mapped_char_source.h
+ * 		Declaraciones de la clase commons::io::mapped_char_source
+******************************************************************************/
+#ifndef __COMMONS_IO_MAPPED_CHAR_SOURCE_H_INCLUDED__
+#define __COMMONS_IO_MAPPED_CHAR_SOURCE_H_INCLUDED__
+
+#include "char_source.h"
+#include <cstddef>
+#include <vector>
+#include <string>
+
+namespace commons {
+namespace io {
+
+/**
+ * Implementación de un origen de chars que mapea un archivo
+ * completo a memoria de sólo lectura. Los chars se copian
+ * directamente desde el mapeo, sin pasar por un stream.
+ *
+ * Sólo se mapean los archivos regulares que informan su tamaño.
+ * Los FIFOs, /dev/stdin o los archivos de /proc (que dicen medir
+ * 0 bytes) se leen del descriptor con read, hasta el final.
+ */
+class mapped_char_source : public char_source {
+private:
+	std::string filename;
+	int descriptor;
+	const unsigned char *mapping;
+	std::size_t size;
+	std::size_t position;
+
+	// Chars leídos del descriptor cuando no se puede mapear
+	std::vector<unsigned char> buffer;
+	bool exhausted;
+
+	bool fill_buffer();
+
+	mapped_char_source(const mapped_char_source &other);
+	mapped_char_source &operator=(const mapped_char_source &other);
+public:
+	/**
+	 * Crea una nueva instancia de mapped_char_source que lee
+	 * los chars del archivo filename. Si no puede abrirlo o
+	 * mapearlo eleva ioexception.
+	 */
+	mapped_char_source(const char *filename);
+
+	/**
+	 * Override char_source::get_next_char
+	 */
+	virtual std::pair<bool, unsigned char> get_next_char();
+
+	/**
+	 * Override char_source::read
+	 */
+	virtual std::size_t read(unsigned char *buffer, std::size_t size);
+
+	/**
+	 * Libera el mapeo y cierra el archivo
+	 */
+	virtual ~mapped_char_source();
+};
+
+};
+};
+
+#endif
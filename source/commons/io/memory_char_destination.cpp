@@ -0,0 +1,20 @@
+/******************************************************************************
+ * memory_char_destination.cpp
+ * 		Definiciones de la clase commons::io::memory_char_destination
+******************************************************************************/
+#include "memory_char_destination.h"
+
+using namespace commons::io;
+
+memory_char_destination::memory_char_destination(std::vector<unsigned char> &chars)
+: chars(chars) {
+
+}
+
+void memory_char_destination::emit_char(unsigned char c) {
+	chars.push_back(c);
+}
+
+void memory_char_destination::write(const unsigned char *data, std::size_t size) {
+	chars.insert(chars.end(), data, data + size);
+}
@@ -0,0 +1,42 @@
+/******************************************************************************
+ * memory_char_destination.h
+ * 		Declaraciones de la clase commons::io::memory_char_destination
+******************************************************************************/
+#ifndef __COMMONS_IO_MEMORY_CHAR_DESTINATION_H_INCLUDED__
+#define __COMMONS_IO_MEMORY_CHAR_DESTINATION_H_INCLUDED__
+
+#include "char_destination.h"
+#include <vector>
+
+namespace commons {
+namespace io {
+
+/**
+ * Implementación de un destino de chars que los agrega al
+ * final de un vector en memoria
+ */
+class memory_char_destination : public char_destination {
+private:
+	std::vector<unsigned char> &chars;
+public:
+	/**
+	 * Crea una nueva instancia de memory_char_destination
+	 * que agrega los chars al vector dado
+	 */
+	memory_char_destination(std::vector<unsigned char> &chars);
+
+	/**
+	 * Override de char_destination::emit_char
+	 */
+	virtual void emit_char(unsigned char c);
+
+	/**
+	 * Override de char_destination::write
+	 */
+	virtual void write(const unsigned char *data, std::size_t size);
+};
+
+};
+};
+
+#endif
@@ -0,0 +1,28 @@
+/******************************************************************************
+ * memory_char_source.cpp
+ * 		Definiciones de la clase commons::io::memory_char_source
+******************************************************************************/
+#include "memory_char_source.h"
+#include <cstring>
+#include <algorithm>
+
+using namespace commons::io;
+
+memory_char_source::memory_char_source(const unsigned char *data, std::size_t size)
+: data(data), size(size), position(0) {
+
+}
+
+std::pair<bool, unsigned char> memory_char_source::get_next_char() {
+	if (position >= size)
+		return std::make_pair(false, static_cast<unsigned char>(0));
+	return std::make_pair(true, data[position++]);
+}
+
+std::size_t memory_char_source::read(unsigned char *buffer, std::size_t size) {
+	std::size_t count = std::min(size, this->size - position);
+	if (count > 0)
+		std::memcpy(buffer, data + position, count);
+	position += count;
+	return count;
+}
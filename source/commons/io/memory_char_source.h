@@ -0,0 +1,45 @@
+/******************************************************************************
+ * memory_char_source.h
+ * 		Declaraciones de la clase commons::io::memory_char_source
+******************************************************************************/
+#ifndef __COMMONS_IO_MEMORY_CHAR_SOURCE_H_INCLUDED__
+#define __COMMONS_IO_MEMORY_CHAR_SOURCE_H_INCLUDED__
+
+#include "char_source.h"
+#include <cstddef>
+
+namespace commons {
+namespace io {
+
+/**
+ * Implementación de un origen de chars que lee de un buffer en
+ * memoria. El buffer no se copia, así que DEBE existir mientras
+ * se use el origen.
+ */
+class memory_char_source : public char_source {
+private:
+	const unsigned char *data;
+	std::size_t size;
+	std::size_t position;
+public:
+	/**
+	 * Crea una nueva instancia de memory_char_source que lee
+	 * los size chars de data
+	 */
+	memory_char_source(const unsigned char *data, std::size_t size);
+
+	/**
+	 * Override char_source::get_next_char
+	 */
+	virtual std::pair<bool, unsigned char> get_next_char();
+
+	/**
+	 * Override char_source::read
+	 */
+	virtual std::size_t read(unsigned char *buffer, std::size_t size);
+};
+
+};
+};
+
+#endif
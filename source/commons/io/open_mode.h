@@ -0,0 +1,28 @@
+/******************************************************************************
+ * open_mode.h
+ * 		Declaraciones del enum commons::io::open_mode
+******************************************************************************/
+#ifndef __COMMONS_IO_OPEN_MODE_H_INCLUDED__
+#define __COMMONS_IO_OPEN_MODE_H_INCLUDED__
+
+namespace commons {
+namespace io {
+
+/**
+ * Modo de apertura de un archivo. Un archivo abierto con
+ * read_only tiene que existir y no se modifica nunca, así que
+ * varios procesos lo pueden compartir. Uno abierto con temporary
+ * se escribe igual que con read_write, pero nada se vuelve a abrir
+ * por nombre ni se persiste al cerrarlo, así que se puede borrar
+ * apenas se abre.
+ */
+enum open_mode {
+	read_write,
+	read_only,
+	temporary
+};
+
+};
+};
+
+#endif
@@ -3,6 +3,7 @@
  * 		Definiciones de la clase commons::io::recycling_block_file
 ******************************************************************************/
 #include "recycling_block_file.h"
+#include "block_file_factory.h"
 #include "../assertions/assertions.h"
 
 using namespace commons::io;
@@ -15,56 +16,70 @@ void recycling_block_file::availability_initializer::initialize(block_file *file
 }
 
 void recycling_block_file::read_availability_block() {
-	file.read_block_into(0, &availability.get_block());
+	file->read_block_into(0, &availability.get_block());
 }
 
 void recycling_block_file::write_availability_block() {
-	file.write_block(0, availability.get_block());
+	file->write_block(0, availability.get_block());
 }
 
-recycling_block_file::recycling_block_file(const char *filename, int block_size)
-: availability(block_size), file(filename, block_size, availability_initializer()) {
+recycling_block_file::recycling_block_file(const char *filename, int block_size, int cache_size)
+: availability(block_size), file(block_file_factory::open_block_file(filename, block_size, availability_initializer(), cache_size)) {
 	read_availability_block();
 }
 
-recycling_block_file::recycling_block_file(const char *filename, int block_size, const recycling_block_file::initializer &initializer)
-: availability(block_size), file(filename, block_size, availability_initializer()) {
+recycling_block_file::recycling_block_file(const char *filename, int block_size, const recycling_block_file::initializer &initializer, int cache_size)
+: availability(block_size), file(block_file_factory::open_block_file(filename, block_size, availability_initializer(), cache_size)) {
 	read_availability_block();
-	if (file.is_just_created())
+	if (file->is_just_created())
 		initializer.initialize(this);
 
 }
 
+recycling_block_file::recycling_block_file(const char *filename, int block_size, const recycling_block_file::initializer &initializer, open_mode mode)
+: availability(block_size),
+  file(mode == read_only
+		? block_file_factory::open_read_only_block_file(filename, block_size)
+		: block_file_factory::open_block_file(filename, block_size, availability_initializer())) {
+	read_availability_block();
+	if (file->is_just_created())
+		initializer.initialize(this);
+}
+
 void recycling_block_file::close() {
-	file.close();
+	file->close();
+}
+
+void recycling_block_file::flush() {
+	file->flush();
 }
 
 block recycling_block_file::read_block(int position) {
 	ASSERTION(!availability.is_available(position));
 
-	return file.read_block(position + 1);
+	return file->read_block(position + 1);
 }
 
 void recycling_block_file::read_block_into(int position, block *b) {
 	ASSERTION(!availability.is_available(position));
 
-	file.read_block_into(position + 1, b);
+	file->read_block_into(position + 1, b);
 }
 
 void recycling_block_file::write_block(int position, const block &b) {
 	ASSERTION(!availability.is_available(position));
 
-	file.write_block(position + 1, b);
+	file->write_block(position + 1, b);
 }
 
 int recycling_block_file::append_block(const block &b) {
 	int available_position = availability.first_available();
 
 	if (available_position >= 0) {
-		file.write_block(available_position + 1, b);
+		file->write_block(available_position + 1, b);
 	} else {
-		file.append_block(b);
-		available_position = file.get_block_count() - 2;
+		file->append_block(b);
+		available_position = file->get_block_count() - 2;
 	}
 
 	availability.make_unavailable(available_position);
@@ -76,8 +91,8 @@ int recycling_block_file::reserve_block() {
 	int available_position = availability.first_available();
 
 	if (available_position < 0) {
-		file.append_block(block(get_block_size()));
-		available_position = file.get_block_count() - 2;
+		file->append_block(block(get_block_size()));
+		available_position = file->get_block_count() - 2;
 	}
 
 	availability.make_unavailable(available_position);
@@ -92,7 +107,7 @@ void recycling_block_file::release_block(int position) {
 
 int recycling_block_file::get_block_count() {
 	int amount = 0;
-	for (int i = 0; i < file.get_block_count() - 1; i++) {
+	for (int i = 0; i < file->get_block_count() - 1; i++) {
 		if (!availability.is_available(i)) amount++;
 	}
 
@@ -104,7 +119,7 @@ int recycling_block_file::get_first_occupied() {
 }
 
 int recycling_block_file::get_next_occupied(int current) {
-	for (current++; current <= file.get_block_count() - 2; current++) {
+	for (current++; current <= file->get_block_count() - 2; current++) {
 		if (!availability.is_available(current))
 			return current;
 	}
@@ -113,7 +128,15 @@ int recycling_block_file::get_next_occupied(int current) {
 }
 
 int recycling_block_file::get_block_size() const {
-	return file.get_block_size();
+	return file->get_block_size();
+}
+
+unsigned int recycling_block_file::get_cache_hits() const {
+	return file->get_cache_hits();
+}
+
+unsigned int recycling_block_file::get_cache_misses() const {
+	return file->get_cache_misses();
 }
 
 recycling_block_file::~recycling_block_file() {
@@ -7,6 +7,7 @@
 
 #include "block_file.h"
 #include "block_availability.h"
+#include <memory>
 
 namespace commons {
 namespace io {
@@ -19,7 +20,7 @@ namespace io {
 class recycling_block_file {
 private:
 	block_availability availability;
-	block_file file;
+	std::auto_ptr<block_file> file;
 
 	/**
 	 * Comando de inicialización del archivo. Utilizado para
@@ -54,23 +55,42 @@ public:
 	/**
 	 * Crea una nueva instancia de recycling_block_file, abriendo
 	 * el archivo dado por filename que contiene bloques de tamaño
-	 * block_size.
+	 * block_size. Mantiene en memoria hasta cache_size bytes de
+	 * bloques.
 	 */
-	recycling_block_file(const char *filename, int block_size);
+	recycling_block_file(const char *filename, int block_size, int cache_size = BLOCK_FILE_CACHE_SIZE);
 
 	/**
 	 * Crea una nueva instancia de recycling_block_file, abriendo el
 	 * archivo dado por filename que contiene bloques de tamaño
 	 * block_size. Si el archivo no existe, lo crea y llama al
-	 * initializer para que este lo inicialice.
+	 * initializer para que este lo inicialice. Mantiene en memoria
+	 * hasta cache_size bytes de bloques.
 	 */
-	recycling_block_file(const char *filename, int block_size, const initializer &initializer);
+	recycling_block_file(const char *filename, int block_size, const initializer &initializer, int cache_size = BLOCK_FILE_CACHE_SIZE);
 
 	/**
-	 * Cierra el archivo.
+	 * Crea una nueva instancia de recycling_block_file, abriendo el
+	 * archivo dado por filename en el modo dado. En modo read_write
+	 * o temporary es igual al constructor anterior; en modo
+	 * read_only el archivo tiene que existir, se abre con
+	 * block_file_factory::open_read_only_block_file y cualquier
+	 * operación que lo modifique eleva ioexception.
+	 */
+	recycling_block_file(const char *filename, int block_size, const initializer &initializer, open_mode mode);
+
+	/**
+	 * Escribe en el archivo todos los bloques modificados que
+	 * estén en la cache y cierra el archivo.
 	 */
 	virtual void close();
 
+	/**
+	 * Escribe en el archivo todos los bloques modificados que
+	 * estén en la cache.
+	 */
+	virtual void flush();
+
 	/**
 	 * Lee el bloque en la posición position y lo devuelve
 	 */
@@ -131,6 +151,18 @@ public:
 	 */
 	virtual int get_block_size() const;
 
+	/**
+	 * Devuelve la cantidad de lecturas de bloques que se
+	 * resolvieron desde la cache
+	 */
+	unsigned int get_cache_hits() const;
+
+	/**
+	 * Devuelve la cantidad de lecturas de bloques que tuvieron
+	 * que ir al archivo
+	 */
+	unsigned int get_cache_misses() const;
+
 	virtual ~recycling_block_file();
 };
 
@@ -4,7 +4,8 @@
  * 		del bloque
 ******************************************************************************/
 #include "serializators.h"
-#include <sstream>
+#include <string>
+#include <algorithm>
 
 // Implementación especial para chars, por cuestiones de eficiencia
 template<>
@@ -57,11 +58,22 @@ std::string commons::io::deserialize<std::string>(const block &b, int index) {
 	std::string::size_type length = deserialize<std::string::size_type>(b, position);
 	position += serialization_length<std::string::size_type>(b, position);
 
-	std::stringstream result_builder;
+	return std::string(b.raw_char_pointer() + position, length);
+}
 
-	for (std::string::size_type i = 0; i < length; i++) {
-		result_builder << deserialize<std::string::value_type>(b, position + i);
-	}
+template<>
+int commons::io::compare_serialized<std::string>(const std::string &instance, const block &b, int index) {
+	std::string::size_type length = deserialize<std::string::size_type>(b, index);
+	const char *serialized = b.raw_char_pointer() + index + serialization_length<std::string::size_type>(b, index);
 
-	return result_builder.str();
+	// Mismo orden que std::string::compare: primero los chars en
+	// común y, si son iguales, el más corto es el menor
+	int result = std::char_traits<char>::compare(instance.data(), serialized, std::min(instance.size(), length));
+	if (result != 0)
+		return result;
+	if (instance.size() < length)
+		return -1;
+	if (instance.size() > length)
+		return 1;
+	return 0;
 }
@@ -44,6 +44,16 @@ void serialize(const T&instance, block *b, int index);
 template<typename T>
 T deserialize(const block &b, int index);
 
+/**
+ * Compara instance con la instancia serializada en el bloque b
+ * a partir del índice index, sin construir una copia de esta
+ * última cuando el tipo lo permite. Devuelve un número negativo,
+ * cero o positivo si instance es menor, igual o mayor a la
+ * instancia serializada, con el mismo orden que operator<.
+ */
+template<typename T>
+int compare_serialized(const T &instance, const block &b, int index);
+
 
 // Implementación genérica para tipos shallow
 template<typename T>
@@ -71,6 +81,16 @@ T deserialize(const block &b, int index) {
 	return *serialized;
 }
 
+template<typename T>
+int compare_serialized(const T &instance, const block &b, int index) {
+	T serialized = deserialize<T>(b, index);
+	if (instance < serialized)
+		return -1;
+	if (serialized < instance)
+		return 1;
+	return 0;
+}
+
 // Implementación especial para chars, por cuestiones de eficiencia
 template<>
 int serialization_length<char>(const char &instance);
@@ -98,6 +118,10 @@ void serialize<std::string>(const std::string &instance, block *b, int index);
 template<>
 std::string deserialize<std::string>(const block &b, int index);
 
+// Los strings se comparan directamente contra los chars del bloque
+template<>
+int compare_serialized<std::string>(const std::string &instance, const block &b, int index);
+
 };
 };
 
@@ -3,27 +3,47 @@
  * 		Definiciones de la clase commons::io::stream_binary_destination
 ******************************************************************************/
 #include "stream_binary_destination.h"
+#include "../../config/config.h"
 
 using namespace commons::io;
 
 stream_binary_destination::stream_binary_destination(std::ostream &o)
-: o(o), current_char(0), current_char_position(0) {
-
+: o(o), pending_bits(0), pending_count(0) {
+	buffer.reserve(BINARY_STREAM_BUFFER_SIZE);
 }
 
 void stream_binary_destination::emit_bit(bool bit) {
-	if (current_char_position >= 8) {
-		o.put(current_char);
-		current_char_position = 0;
-		current_char = 0;
+	emit_bits(bit ? 1 : 0, 1);
+}
+
+void stream_binary_destination::emit_bits(uint64_t value, int count) {
+	// Quedan a lo sumo 7 bits pendientes, así que agregando de a
+	// 32 bits como máximo nunca se llenan los 64 del acumulador
+	if (count > 32) {
+		emit_bits(value >> 32, count - 32);
+		count = 32;
 	}
 
-	if (bit)
-		current_char |= (1 << (7 - current_char_position));
-	current_char_position++;
+	pending_bits = (pending_bits << count) | (value & ((static_cast<uint64_t>(1) << count) - 1));
+	pending_count += count;
+	while (pending_count >= 8) {
+		pending_count -= 8;
+		buffer.push_back(static_cast<char>(pending_bits >> pending_count));
+	}
+
+	if (buffer.size() >= BINARY_STREAM_BUFFER_SIZE)
+		flush_buffer();
+}
+
+void stream_binary_destination::flush_buffer() {
+	if (!buffer.empty())
+		o.write(&buffer[0], buffer.size());
+	buffer.clear();
 }
 
 stream_binary_destination::~stream_binary_destination() {
-	if (current_char_position > 0)
-		o.put(current_char);
+	// El último byte se completa con ceros
+	if (pending_count > 0)
+		buffer.push_back(static_cast<char>(pending_bits << (8 - pending_count)));
+	flush_buffer();
 }
@@ -7,18 +7,25 @@
 
 #include "binary_destination.h"
 #include <iostream>
+#include <vector>
 
 namespace commons {
 namespace io {
 
 /**
- * Implementación de un destino de bits a un stream
+ * Implementación de un destino de bits a un stream. Los bits se
+ * acumulan en un entero de 64 bits y los bytes completos en un
+ * buffer de BINARY_STREAM_BUFFER_SIZE bytes, que se escribe en el
+ * stream de una vez al llenarse o al destruir el destino.
  */
 class stream_binary_destination : public binary_destination {
 private:
 	std::ostream &o;
-	char current_char;
-	char current_char_position;
+	uint64_t pending_bits;
+	int pending_count;
+	std::vector<char> buffer;
+
+	void flush_buffer();
 public:
 	/**
 	 * Crea una nueva instancia de stream_binary_destination
@@ -31,6 +38,11 @@ public:
 	 */
 	virtual void emit_bit(bool bit);
 
+	/**
+	 * Override de binary_destination::emit_bits
+	 */
+	virtual void emit_bits(uint64_t value, int count);
+
 	virtual ~stream_binary_destination();
 };
 
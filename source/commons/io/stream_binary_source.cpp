@@ -3,30 +3,60 @@
  * 		Definiciones de la clase commons::io::stream_binary_source
 ******************************************************************************/
 #include "stream_binary_source.h"
+#include "../../config/config.h"
 
 using namespace commons::io;
 
 stream_binary_source::stream_binary_source(std::istream &s)
-: s(s), current_char(0), current_char_position(8), eof(false) {
+: s(s), buffer(BINARY_STREAM_BUFFER_SIZE), buffer_position(0), buffer_size(0), pending_bits(0), pending_count(0), eof(false) {
 
 }
 
 std::pair<bool, bool> stream_binary_source::get_next_bit() {
-	if (eof)
-		return std::make_pair(false, false);
-
-	std::pair<bool, bool> result;
-	// Si la posición que tengo que devolver ahora está
-	// más adelante del char actual, tengo que cargar el
-	// siguiente char desde el stream
-	if (current_char_position >= 8) {
-		current_char_position = 0;
-		result.first = s.get(current_char);
-		eof = !result.first;
-	} else {
-		result.first = true;
+	std::pair<bool, uint64_t> result = read_bits(1);
+	return std::make_pair(result.first, result.second != 0);
+}
+
+std::pair<bool, uint64_t> stream_binary_source::read_bits(int count) {
+	// El acumulador tiene lugar para 56 bits más los que sobran
+	// del último byte, así que pido de a 32 bits como máximo
+	if (count > 32) {
+		std::pair<bool, uint64_t> high = read_bits(count - 32);
+		std::pair<bool, uint64_t> low = read_bits(32);
+		return std::make_pair(high.first && low.first, (high.second << 32) | low.second);
+	}
+
+	if (!fill_pending_bits(count)) {
+		// Completo con ceros los bits que faltan
+		pending_bits <<= count - pending_count;
+		uint64_t value = pending_bits & ((static_cast<uint64_t>(1) << count) - 1);
+		pending_bits = 0;
+		pending_count = 0;
+		return std::make_pair(false, value);
+	}
+
+	pending_count -= count;
+	uint64_t value = (pending_bits >> pending_count) & ((static_cast<uint64_t>(1) << count) - 1);
+	return std::make_pair(true, value);
+}
+
+bool stream_binary_source::fill_pending_bits(int count) {
+	while (pending_count < count) {
+		if (buffer_position == buffer_size) {
+			if (eof)
+				return false;
+
+			// Cargo el siguiente tramo del stream
+			s.read(&buffer[0], buffer.size());
+			buffer_size = s.gcount();
+			buffer_position = 0;
+			eof = buffer_size < buffer.size();
+			if (buffer_size == 0)
+				return false;
+		}
+
+		pending_bits = (pending_bits << 8) | static_cast<unsigned char>(buffer[buffer_position++]);
+		pending_count += 8;
 	}
-	result.second = current_char & (1 << (7 - current_char_position));
-	current_char_position++;
-	return result;
+	return true;
 }
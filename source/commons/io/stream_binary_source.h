@@ -7,20 +7,28 @@
 
 #include "binary_source.h"
 #include <iostream>
+#include <vector>
 
 namespace commons {
 namespace io {
 
 /**
  * Implementación de un origen de bits individuales
- * desde un stream.
+ * desde un stream. Lee el stream de a BINARY_STREAM_BUFFER_SIZE
+ * bytes y entrega los bits desde un acumulador de 64 bits, por
+ * lo que puede leer del stream más allá del último bit pedido.
  */
 class stream_binary_source : public binary_source {
 private:
 	std::istream &s;
-	char current_char;
-	char current_char_position;
+	std::vector<char> buffer;
+	std::size_t buffer_position;
+	std::size_t buffer_size;
+	uint64_t pending_bits;
+	int pending_count;
 	bool eof;
+
+	bool fill_pending_bits(int count);
 public:
 	/**
 	 * Crea una nueva instancia de stream_binary_source
@@ -32,6 +40,11 @@ public:
 	 * Override de binary_source::get_next_bit
 	 */
 	virtual std::pair<bool, bool> get_next_bit();
+
+	/**
+	 * Override de binary_source::read_bits
+	 */
+	virtual std::pair<bool, uint64_t> read_bits(int count);
 };
 
 };
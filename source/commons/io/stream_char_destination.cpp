@@ -3,14 +3,39 @@
  * 		Definiciones de la clase commons::io::stream_char_destination
 ******************************************************************************/
 #include "stream_char_destination.h"
+#include "../../config/config.h"
 
 using namespace commons::io;
 
 stream_char_destination::stream_char_destination(std::ostream &o)
 : o(o) {
-
+	buffer.reserve(CHAR_STREAM_BUFFER_SIZE);
 }
 
 void stream_char_destination::emit_char(unsigned char c) {
-	o << c;
+	buffer.push_back(c);
+	if (buffer.size() >= CHAR_STREAM_BUFFER_SIZE)
+		flush_buffer();
+}
+
+void stream_char_destination::write(const unsigned char *data, std::size_t size) {
+	// Los tramos grandes van directo al stream, sin pasar por el buffer
+	if (buffer.size() + size > CHAR_STREAM_BUFFER_SIZE) {
+		flush_buffer();
+		if (size >= CHAR_STREAM_BUFFER_SIZE) {
+			o.write(reinterpret_cast<const char *>(data), size);
+			return;
+		}
+	}
+	buffer.insert(buffer.end(), data, data + size);
+}
+
+void stream_char_destination::flush_buffer() {
+	if (!buffer.empty())
+		o.write(reinterpret_cast<const char *>(&buffer[0]), buffer.size());
+	buffer.clear();
+}
+
+stream_char_destination::~stream_char_destination() {
+	flush_buffer();
 }
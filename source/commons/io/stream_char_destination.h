@@ -7,16 +7,23 @@
 
 #include "char_destination.h"
 #include <iostream>
+#include <vector>
 
 namespace commons {
 namespace io {
 
 /**
- * Implementación de un destino de chars a un stream
+ * Implementación de un destino de chars a un stream. Los chars
+ * se acumulan en un buffer de CHAR_STREAM_BUFFER_SIZE bytes que
+ * se escribe en el stream de una vez al llenarse o al destruir
+ * el destino.
  */
 class stream_char_destination : public char_destination {
 private:
 	std::ostream &o;
+	std::vector<unsigned char> buffer;
+
+	void flush_buffer();
 public:
 	/**
 	 * Crea una nueva instancia de stream_char_destination
@@ -28,6 +35,13 @@ public:
 	 * Override de char_destination::emit_char
 	 */
 	virtual void emit_char(unsigned char c);
+
+	/**
+	 * Override de char_destination::write
+	 */
+	virtual void write(const unsigned char *data, std::size_t size);
+
+	virtual ~stream_char_destination();
 };
 
 };
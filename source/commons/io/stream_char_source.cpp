@@ -18,3 +18,8 @@ std::pair<bool, unsigned char> stream_char_source::get_next_char() {
 	result.second = data;
 	return result;
 }
+
+std::size_t stream_char_source::read(unsigned char *buffer, std::size_t size) {
+	s.read(reinterpret_cast<char *>(buffer), size);
+	return s.gcount();
+}
@@ -28,6 +28,11 @@ public:
 	 * Override char_source::get_next_char
 	 */
 	virtual std::pair<bool, unsigned char> get_next_char();
+
+	/**
+	 * Override char_source::read
+	 */
+	virtual std::size_t read(unsigned char *buffer, std::size_t size);
 };
 
 };
@@ -0,0 +1,35 @@
+/******************************************************************************
+ * checksum_utils.cpp
+ * 		Definiciones de las funciones de commons::utils::checksum
+******************************************************************************/
+#include "checksum_utils.h"
+
+namespace {
+
+// Tabla del CRC de cada byte posible, que se arma antes de main
+// para que no haya que sincronizar su inicialización entre threads
+struct crc_table {
+	unsigned int entries[256];
+
+	crc_table() {
+		for (unsigned int i = 0; i < 256; i++) {
+			unsigned int value = i;
+			for (int bit = 0; bit < 8; bit++) {
+				value = (value & 1) ? (value >> 1) ^ 0xEDB88320u : value >> 1;
+			}
+			entries[i] = value;
+		}
+	}
+};
+
+const crc_table table;
+
+};
+
+unsigned int commons::utils::checksum::crc32(const unsigned char *data, std::size_t size, unsigned int crc) {
+	crc = ~crc;
+	for (std::size_t i = 0; i < size; i++) {
+		crc = table.entries[(crc ^ data[i]) & 0xFFu] ^ (crc >> 8);
+	}
+	return ~crc;
+}
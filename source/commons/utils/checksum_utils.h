@@ -0,0 +1,26 @@
+/******************************************************************************
+ * checksum_utils.h
+ * 		Declaraciones de las funciones de commons::utils::checksum
+******************************************************************************/
+#ifndef __COMMONS_UTILS_CHECKSUM_UTILS_H_INCLUDED__
+#define __COMMONS_UTILS_CHECKSUM_UTILS_H_INCLUDED__
+
+#include <cstddef>
+
+namespace commons {
+namespace utils {
+namespace checksum {
+
+/**
+ * Extiende el CRC-32 (el mismo polinomio que zlib) de una
+ * secuencia de bytes con los size bytes de data. El CRC de la
+ * secuencia vacía es 0, así que crc32(data, size) es el CRC de
+ * data.
+ */
+unsigned int crc32(const unsigned char *data, std::size_t size, unsigned int crc = 0);
+
+};
+};
+};
+
+#endif
@@ -0,0 +1,27 @@
+/******************************************************************************
+ * hash_utils.cpp
+ * 		Definiciones de las funciones de commons::utils::hashing
+******************************************************************************/
+#include "hash_utils.h"
+
+unsigned int commons::utils::hashing::finish_state(unsigned int state) {
+	// Mezcla final de MurmurHash3
+	state ^= state >> 16;
+	state *= 0x85ebca6bu;
+	state ^= state >> 13;
+	state *= 0xc2b2ae35u;
+	state ^= state >> 16;
+	return state;
+}
+
+unsigned int commons::utils::hashing::hash_chars(const char *data, std::size_t length) {
+	unsigned int state = initial_state;
+	for (std::size_t i = 0; i < length; i++) {
+		state = extend_state(state, static_cast<unsigned char>(data[i]));
+	}
+	return finish_state(state);
+}
+
+unsigned int commons::utils::hashing::hash_string(const std::string &s) {
+	return hash_chars(s.data(), s.size());
+}
@@ -0,0 +1,51 @@
+/******************************************************************************
+ * hash_utils.h
+ * 		Declaraciones de las funciones de commons::utils::hashing
+******************************************************************************/
+#ifndef __COMMONS_UTILS_HASH_UTILS_H_INCLUDED__
+#define __COMMONS_UTILS_HASH_UTILS_H_INCLUDED__
+
+#include <string>
+#include <cstddef>
+
+namespace commons {
+namespace utils {
+namespace hashing {
+
+/**
+ * Estado inicial del hash de una secuencia de chars, que
+ * corresponde a la secuencia vacía
+ */
+const unsigned int initial_state = 2166136261u;
+
+/**
+ * Extiende el estado del hash de una secuencia de chars
+ * con un char más al final (FNV-1a). El hash de s + c puede
+ * obtenerse del estado de s sin volver a recorrer s.
+ */
+inline unsigned int extend_state(unsigned int state, unsigned char c) {
+	return (state ^ c) * 16777619u;
+}
+
+/**
+ * Obtiene el hash final a partir del estado de una secuencia,
+ * mezclando los bits para que todos dependan de todos los
+ * chars de la secuencia
+ */
+unsigned int finish_state(unsigned int state);
+
+/**
+ * Calcula el hash de una secuencia de length chars
+ */
+unsigned int hash_chars(const char *data, std::size_t length);
+
+/**
+ * Calcula el hash de un string
+ */
+unsigned int hash_string(const std::string &s);
+
+};
+};
+};
+
+#endif
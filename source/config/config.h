@@ -63,11 +63,64 @@
  */
 #define BPLUS_BLOCK_SIZE 8192
 
+/**
+ * Establece la cantidad de bytes de bloques que cada archivo
+ * de bloques mantiene en memoria. En 0 deshabilita la cache.
+ */
+#define BLOCK_FILE_CACHE_SIZE 1048576
+
+/**
+ * Define si los archivos de bloques de los contenedores se mapean
+ * a memoria (1) o se acceden a través de un stream con cache (0)
+ */
+#define BLOCK_FILE_MAPPED 0
+
+/**
+ * Establece de a cuántos bytes crece el mapeo de un archivo de
+ * bloques mapeado a memoria
+ */
+#define BLOCK_FILE_MAPPED_EXTENT_SIZE 16777216
+
+/**
+ * Establece de a cuántos bytes leen y escriben en su stream los
+ * orígenes y destinos de bits
+ */
+#define BINARY_STREAM_BUFFER_SIZE 65536
+
+/**
+ * Establece de a cuántos bytes se leen y escriben los chars
+ * en los orígenes y destinos de chars, y en el compresor
+ */
+#define CHAR_STREAM_BUFFER_SIZE 65536
+
+/**
+ * Establece la cantidad máxima de bytes que puede ocupar el
+ * trie de contextos en memoria
+ */
+#define TRIE_MEMORY_LIMIT 67108864
+
 /**
  * Define si se compilan las assertions o no
  */
 #define BUILD_OPTIONS_ASSERTIONS 1
 
+/**
+ * Establece la cantidad máxima de símbolos distintos que una
+ * distribución de símbolos guarda en su representación compacta
+ * antes de pasar a la representación con un contador por símbolo
+ */
+#define ARITHMETIC_SPARSE_DISTRIBUTION_LIMIT 12
+
+/**
+ * Establece la frecuencia total a partir de la cual una distribución
+ * de símbolos divide a la mitad todas sus frecuencias, de manera que
+ * las emisiones recientes pesen más que las viejas. DEBE ser menor a
+ * 65535, para que las frecuencias entren en 16 bits, y a
+ * 2^(ARITHMETIC_COMPRESSOR_PRECISION - 2) para que las distribuciones
+ * se puedan usar con arithmetic::compressor.
+ */
+#define ARITHMETIC_DISTRIBUTION_RESCALE_LIMIT 4095
+
 /**
  * Define la cantidad de bits, o precisión,
  * del compresor aritmético
@@ -25,11 +25,6 @@ protected:
 	 */
 	virtual int get_metadata_length() const;
 
-	/**
-	 * Override element_container_block
-	 */
-	virtual int make_room_for_element(const K &key, const T &value);
-
 	/**
 	 * Override element_container_block
 	 */
@@ -112,11 +107,6 @@ int bucket<K, T>::get_metadata_length() const {
 	return sizeof(int);
 }
 
-template<typename K, typename T>
-int bucket<K, T>::make_room_for_element(const K &key, const T &value) {
-	return parent::get_free_index();
-}
-
 template<typename K, typename T>
 void bucket<K, T>::handle_insertion_overflow(const K &key, const T &value, int total_required_size) {
 	handle_overflow();
@@ -71,8 +71,9 @@ public:
 	 * persistente es el archivo indicador por path, con un tamaño
 	 * de bloque block_size. Crea este archivo y lo inicializa,
 	 * si este no existe, o abre el archivo si este ya existía.
+	 * En modo read_only el archivo tiene que existir.
 	 */
-	explicit bucket_table(const std::string &path, int block_size);
+	explicit bucket_table(const std::string &path, int block_size, commons::io::open_mode mode = commons::io::read_write);
 
 	/**
 	 * Agrega un bucket en alguna posición disponible del archivo.
@@ -154,8 +155,8 @@ bool bucket_table<K, T>::iterator::operator!=(const iterator &other) const {
 
 
 template<typename K, typename T>
-bucket_table<K, T>::bucket_table(const std::string &path, int block_size)
-: file(path.c_str(), block_size, block_file_initializer()) {
+bucket_table<K, T>::bucket_table(const std::string &path, int block_size, commons::io::open_mode mode)
+: file(path.c_str(), block_size, block_file_initializer(), mode) {
 
 }
 
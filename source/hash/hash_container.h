@@ -10,6 +10,8 @@
 #include "hash_table.h"
 #include <utility>
 #include <iostream>
+#include <vector>
+#include <algorithm>
 
 namespace hash {
 
@@ -26,15 +28,21 @@ private:
 	hash_table<K> table;
 
 	void handle_overflow(const bucket<K, T> overflow_bucket, int overflow_position);
+	void upsert_hashed_element(const K &key, unsigned int key_hash, const T &value);
+	void hash_keys(const std::vector<K> &keys, std::vector<unsigned int> &hashes) const;
+	void sort_by_bucket_position(const std::vector<unsigned int> &hashes, std::vector<std::pair<int, int> > &positions);
 public:
 
 	/**
 	 * Crea una nueva instancia de hash_container, cuyo
 	 * archivo de datos es data_file, archivo de indexado
 	 * es index_file y el tamaño de bloque del archivo de
-	 * datos es block_size
+	 * datos es block_size. En modo read_only los archivos
+	 * tienen que existir, y cualquier modificación eleva
+	 * commons::io::ioexception. En modo temporary los archivos
+	 * se pueden borrar apenas se crea el contenedor.
 	 */
-	hash_container(const char *data_filename, const char *index_filename, int block_size);
+	hash_container(const char *data_filename, const char *index_filename, int block_size, commons::io::open_mode mode = commons::io::read_write);
 
 	/**
 	 * Agrega un elemento al contenedor. Valida si el
@@ -50,6 +58,13 @@ public:
 	 */
 	void update_element(const K &key, const T &value);
 
+	/**
+	 * Modifica un elemento si existe en el contenedor, o
+	 * lo agrega en caso contrario, leyendo y guardando una
+	 * única vez su bucket mientras no haya overflow.
+	 */
+	void upsert_element(const K &key, const T &value);
+
 	/**
 	 * Elimina un elemento existente en el contenedor.
 	 * Valida que el elemento exista, en caso contrario
@@ -65,6 +80,31 @@ public:
 	 */
 	std::pair<bool, T> search_for_element(const K &key);
 
+	/**
+	 * Busca varios elementos en el contenedor, leyendo una
+	 * única vez cada bucket involucrado.
+	 */
+	virtual void search_for_elements(const std::vector<K> &keys, std::vector<typename parent::search_result_type> &results);
+
+	/**
+	 * Modifica o agrega varios elementos en el contenedor,
+	 * leyendo y guardando una única vez cada bucket involucrado
+	 * mientras no haya overflow.
+	 */
+	virtual void upsert_elements(const std::vector<K> &keys, const std::vector<T> &values);
+
+	/**
+	 * Igual que search_for_elements, pero ubica los buckets
+	 * con los hashes dados en lugar de calcularlos.
+	 */
+	virtual void search_for_hashed_elements(const std::vector<K> &keys, const std::vector<unsigned int> &hashes, std::vector<typename parent::search_result_type> &results);
+
+	/**
+	 * Igual que upsert_elements, pero ubica los buckets
+	 * con los hashes dados en lugar de calcularlos.
+	 */
+	virtual void upsert_hashed_elements(const std::vector<K> &keys, const std::vector<unsigned int> &hashes, const std::vector<T> &values);
+
 	/**
 	 * Vuelca el contenido de la estructura de datos en
 	 * un stream dado.
@@ -78,12 +118,20 @@ public:
 	 */
 	virtual void inspect(container::element_inspector<K, T> &inspector);
 
+	/**
+	 * Guarda la tabla de dispersión en el archivo de indexado, salvo
+	 * en modo read_only o temporary. Si no se puede escribir eleva
+	 * commons::io::ioexception. Al destruirse el contenedor la guarda
+	 * igual, pero sin poder informar errores.
+	 */
+	void close();
+
 };
 
 template<typename K, typename T>
-hash_container<K, T>::hash_container(const char *data_filename, const char *index_filename, int block_size)
-: buckets(data_filename, block_size),
-  table(index_filename) {
+hash_container<K, T>::hash_container(const char *data_filename, const char *index_filename, int block_size, commons::io::open_mode mode)
+: buckets(data_filename, block_size, mode),
+  table(index_filename, mode) {
 
 }
 
@@ -136,6 +184,32 @@ void hash_container<K, T>::update_element(const K &key, const T &value) {
 	}
 }
 
+template<typename K, typename T>
+void hash_container<K, T>::upsert_element(const K &key, const T &value) {
+	upsert_hashed_element(key, hash_key(key), value);
+}
+
+template<typename K, typename T>
+void hash_container<K, T>::upsert_hashed_element(const K &key, unsigned int key_hash, const T &value) {
+	bool upsert_successful = false;
+
+	while (!upsert_successful) {
+		// Obtengo la posición en la que va el elemento
+		int bucket_position = table.get_hash_position(key_hash);
+		// Obtengo el bucket que está en esa posición
+		bucket<K, T> actual_bucket = buckets.get_bucket(bucket_position);
+		try {
+			// Modifico o agrego el elemento en el bucket
+			actual_bucket.upsert_element(key, value);
+			// Guardo el bucket modificado
+			buckets.save_bucket(bucket_position, actual_bucket);
+			upsert_successful = true;
+		} catch (typename bucket<K, T>::overflow_exception &overflow) {
+			handle_overflow(actual_bucket, bucket_position);
+		}
+	}
+}
+
 template<typename K, typename T>
 void hash_container<K, T>::delete_element(const K &key) {
 	// Obtengo la posición en la que tendría que estar el
@@ -189,6 +263,77 @@ std::pair<bool, T> hash_container<K, T>::search_for_element(const K &key) {
 	return actual_bucket.get_element(key);
 }
 
+template<typename K, typename T>
+void hash_container<K, T>::search_for_elements(const std::vector<K> &keys, std::vector<typename parent::search_result_type> &results) {
+	std::vector<unsigned int> hashes;
+	hash_keys(keys, hashes);
+	search_for_hashed_elements(keys, hashes, results);
+}
+
+template<typename K, typename T>
+void hash_container<K, T>::search_for_hashed_elements(const std::vector<K> &keys, const std::vector<unsigned int> &hashes, std::vector<typename parent::search_result_type> &results) {
+	std::vector<std::pair<int, int> > positions;
+	sort_by_bucket_position(hashes, positions);
+
+	results.assign(keys.size(), typename parent::search_result_type(false, T()));
+
+	// Recorro las claves agrupadas por bucket
+	typename std::vector<std::pair<int, int> >::size_type current = 0;
+	while (current < positions.size()) {
+		int bucket_position = positions[current].first;
+		bucket<K, T> actual_bucket = buckets.get_bucket(bucket_position);
+
+		for (; current < positions.size() && positions[current].first == bucket_position; current++) {
+			int key_index = positions[current].second;
+			results[key_index] = actual_bucket.get_element(keys[key_index]);
+		}
+	}
+}
+
+template<typename K, typename T>
+void hash_container<K, T>::upsert_elements(const std::vector<K> &keys, const std::vector<T> &values) {
+	std::vector<unsigned int> hashes;
+	hash_keys(keys, hashes);
+	upsert_hashed_elements(keys, hashes, values);
+}
+
+template<typename K, typename T>
+void hash_container<K, T>::upsert_hashed_elements(const std::vector<K> &keys, const std::vector<unsigned int> &hashes, const std::vector<T> &values) {
+	std::vector<std::pair<int, int> > positions;
+	sort_by_bucket_position(hashes, positions);
+
+	// Recorro las claves agrupadas por bucket
+	typename std::vector<std::pair<int, int> >::size_type current = 0;
+	while (current < positions.size()) {
+		int bucket_position = positions[current].first;
+		bucket<K, T> actual_bucket = buckets.get_bucket(bucket_position);
+
+		try {
+			for (; current < positions.size() && positions[current].first == bucket_position; current++) {
+				int key_index = positions[current].second;
+				actual_bucket.upsert_element(keys[key_index], values[key_index]);
+			}
+			buckets.save_bucket(bucket_position, actual_bucket);
+		} catch (typename bucket<K, T>::overflow_exception &overflow) {
+			// El bucket se divide con los cambios que ya tenía; como
+			// eso cambia la dispersión, el resto de las claves del
+			// grupo se guardan de a una. La tabla tiene que recordar
+			// la entrada de la clave que causó el overflow
+			table.get_hash_position(hashes[positions[current].second]);
+			handle_overflow(actual_bucket, bucket_position);
+			for (; current < positions.size() && positions[current].first == bucket_position; current++) {
+				int key_index = positions[current].second;
+				upsert_hashed_element(keys[key_index], hashes[key_index], values[key_index]);
+			}
+		}
+	}
+}
+
+template<typename K, typename T>
+void hash_container<K, T>::close() {
+	table.close();
+}
+
 template<typename K, typename T>
 void hash_container<K, T>::dump_to_stream(std::ostream &output) {
 
@@ -239,6 +384,28 @@ void hash_container<K, T>::inspect(container::element_inspector<K, T> &inspector
 	}
 }
 
+template<typename K, typename T>
+void hash_container<K, T>::hash_keys(const std::vector<K> &keys, std::vector<unsigned int> &hashes) const {
+	hashes.clear();
+	hashes.reserve(keys.size());
+	for (typename std::vector<K>::const_iterator it = keys.begin(); it != keys.end(); it++) {
+		hashes.push_back(hash_key(*it));
+	}
+}
+
+template<typename K, typename T>
+void hash_container<K, T>::sort_by_bucket_position(const std::vector<unsigned int> &hashes, std::vector<std::pair<int, int> > &positions) {
+	// Cada par es (posición del bucket, índice de la clave); al
+	// ordenar quedan juntas las claves del mismo bucket, en el
+	// orden en que fueron dadas
+	positions.clear();
+	positions.reserve(hashes.size());
+	for (std::vector<unsigned int>::size_type i = 0; i < hashes.size(); i++) {
+		positions.push_back(std::make_pair(table.get_hash_position(hashes[i]), static_cast<int>(i)));
+	}
+	std::sort(positions.begin(), positions.end());
+}
+
 template<typename K, typename T>
 void hash_container<K, T>::handle_overflow(const bucket<K, T> overflow_bucket, int overflow_position) {
 	// Si hubo un overflow, tenemos que agregar un nuevo bucket
@@ -5,43 +5,66 @@
 #ifndef __HASH_HASH_TABLE_H_INCLUDED__
 #define __HASH_HASH_TABLE_H_INCLUDED__
 
-#include "../commons/io/block_file.h"
-#include "../commons/io/serializators.h"
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstring>
 #include <utility>
+#include "../commons/utils/hash_utils.h"
+#include "../commons/io/open_mode.h"
+#include "../commons/io/ioexception.h"
+
 namespace hash {
 
+/**
+ * Calcula el hash de una clave, con el que se elige la
+ * entrada de la tabla. Para los tipos enteros es la clave
+ * misma.
+ */
+template<typename K>
+inline unsigned int hash_key(const K &key) {
+	return static_cast<unsigned int>(key);
+}
+
+/**
+ * Calcula el hash de una clave string, mezclando todos sus
+ * chars (ver commons::utils::hashing)
+ */
+inline unsigned int hash_key(const std::string &key) {
+	return commons::utils::hashing::hash_string(key);
+}
+
 /**
  * Mantiene una asociación entre claves y posiciones de buckets.
- * Contiene además un bloque de control que mantiene el tamaño actual
- * de la tabla.
+ * La tabla completa se mantiene en memoria como un arreglo
+ * contiguo, y se guarda en el archivo en una única escritura
+ * secuencial (el tamaño de la tabla seguido de sus entradas)
+ * al llamar a checkpoint o a close, o al destruirse. Como el
+ * destructor no puede informar errores, quien necesite saber si
+ * la tabla se guardó tiene que llamar a close antes.
  */
 template<typename K>
 class hash_table {
 private:
-	commons::io::block_file file;
-
-	int last_used_position;
-	commons::io::block last_used_block;
-	commons::io::block control_block;
+	std::string filename;
+	std::vector<int> entries;
+	bool writable;
 
-	struct block_file_initializer : public commons::io::block_file::initializer {
-		virtual void initialize(commons::io::block_file *file) const;
-	};
+	int last_used_entry;
 
-	int do_hash(const K &key) const;
-	void set_size(int size);
-	int get_position_in_entry(int entry);
-	void set_position_in_entry(int entry, int position);
 	void shrink_if_possible();
 	int normalize_position(int position);
 public:
 	/**
 	 * Crea una nueva instancia de hash_table a partir
-	 * del archivo dado por filename. Crea e inicializa
-	 * el archivo si este no existe, en caso contrario
-	 * carga los contenidos de dicho archivo
+	 * del archivo dado por filename. Si el archivo no
+	 * existe, la tabla empieza con una única entrada que
+	 * apunta a la posición cero; en caso contrario carga
+	 * los contenidos de dicho archivo. En modo read_only
+	 * el archivo tiene que existir, y la tabla no se vuelve
+	 * a guardar al destruirse; en modo temporary tampoco.
 	 */
-	explicit hash_table(const char *filename);
+	explicit hash_table(const char *filename, commons::io::open_mode mode = commons::io::read_write);
 
 	/**
 	 * Devuelve el tamaño actual de la tabla.
@@ -53,6 +76,12 @@ public:
 	 */
 	int get_key_position(const K &key);
 
+	/**
+	 * Obtiene la posición asociada a una clave cuyo hash
+	 * (calculado con hash_key) es key_hash.
+	 */
+	int get_hash_position(unsigned int key_hash);
+
 	/**
 	 * Obtiene la posición a la que apunta un registro
 	 * dado de la tabla
@@ -85,74 +114,81 @@ public:
 	 */
 	std::pair<bool, int> try_position_erasure(int last_position_hash_factor);
 
+	/**
+	 * Guarda la tabla completa en el archivo. Si no se puede
+	 * escribir eleva commons::io::ioexception.
+	 */
+	void checkpoint();
+
+	/**
+	 * Guarda la tabla, salvo en modo read_only o temporary, y no
+	 * la vuelve a guardar al destruirse. Si no se puede escribir
+	 * eleva commons::io::ioexception.
+	 */
+	void close();
+
 	virtual ~hash_table();
 };
 
 template<typename K>
-hash_table<K>::hash_table(const char *filename)
-: file(filename, sizeof(int), block_file_initializer()),
-  last_used_block(sizeof(int)),
-  control_block(sizeof(int)) {
-	file.read_block_into(0, &control_block);
-	file.read_block_into(1, &last_used_block);
-	last_used_position = 1;
+hash_table<K>::hash_table(const char *filename, commons::io::open_mode mode)
+: filename(filename), writable(mode == commons::io::read_write), last_used_entry(0) {
+	std::ifstream file(filename, std::ios_base::in | std::ios_base::binary);
+	if (mode == commons::io::read_only && !file.is_open())
+		throw commons::io::ioexception(std::string("Could not open '") + filename + "'");
+
+	int size = 0;
+	if (file.is_open())
+		file.read(reinterpret_cast<char *>(&size), sizeof(int));
+
+	if (file.is_open() && file && size > 0) {
+		entries.resize(size);
+		file.read(reinterpret_cast<char *>(&entries[0]), size * sizeof(int));
+	} else {
+		// Tabla nueva: todas las claves apuntan a la posición cero
+		entries.assign(1, 0);
+	}
 }
 
 template<typename K>
 int hash_table<K>::get_size() const {
-	return commons::io::deserialize<int>(control_block, 0);
+	return entries.size();
 }
 
 template<typename K>
 int hash_table<K>::get_key_position(const K &key) {
-	// Calculo el hash de la clave. Eso me da el bloque en el que está
-	// la posición de la clave.
-	int position = do_hash(key);
-	// Leo desde el archivo la posición
-	last_used_position = position;
-	file.read_block_into(position, &last_used_block);
-	return commons::io::deserialize<int>(last_used_block, 0);
+	return get_hash_position(hash_key(key));
+}
+
+template<typename K>
+int hash_table<K>::get_hash_position(unsigned int key_hash) {
+	// El hash de la clave me da la entrada en la que
+	// está la posición de la clave.
+	last_used_entry = key_hash % get_size();
+	return entries[last_used_entry];
 }
 
 template<typename K>
 int hash_table<K>::get_table_position(int position) {
-	position++;
-	last_used_position = position;
-	file.read_block_into(position, &last_used_block);
-	return commons::io::deserialize<int>(last_used_block, 0);
+	last_used_entry = position;
+	return entries[last_used_entry];
 }
 
 template<typename K>
 void hash_table<K>::grow() {
-	int active_block_count = get_size();
-	commons::io::block temp_block(file.get_block_size());
-	// Recorro todos los bloque que tengo en este momento
-	for (int i = 1; i <= active_block_count; i++) {
-		// Leo cada bloque
-		file.read_block_into(i, &temp_block);
-		// Si hay una posición disponible en el archivo
-		// escribo en esa posición.
-		if (i + active_block_count < file.get_block_count()) {
-			file.write_block(i + active_block_count, temp_block);
-		// Sino, agrego el bloque al final del archivo
-		} else {
-			file.append_block(temp_block);
-		}
-	}
-	// Actualizo la información de control
-	set_size(get_size() * 2);
+	// Duplico la tabla copiando la mitad inferior en la superior
+	int size = get_size();
+	entries.resize(2 * size);
+	std::memcpy(&entries[size], &entries[0], size * sizeof(int));
 }
 
 template<typename K>
 void hash_table<K>::remap_last_used_entry(int new_position, int previous_hash_factor) {
-	// Actualizo todas las entradas en disco, salteando de a una
+	// Actualizo todas las entradas, salteando de a una
 	int new_hash_factor = 2 * previous_hash_factor;
 	for (int i = 0; i < (get_size() / new_hash_factor); i++) {
-		set_position_in_entry(normalize_position((last_used_position - 1) + (i * new_hash_factor)), new_position);
+		entries[normalize_position(last_used_entry + (i * new_hash_factor))] = new_position;
 	}
-	// Actualizo la copia en memoria de la posición actual
-	// para evitar otro acceso a disco
-	commons::io::serialize(new_position, &last_used_block, 0);
 }
 
 template<typename K>
@@ -163,10 +199,8 @@ std::pair<bool, int> hash_table<K>::try_position_erasure(int last_position_hash_
 
 	// Chequeo si en las posiciones medias entre las repeticiones
 	// de la ultima posición está el mismo puntero
-	int upper_halfway = normalize_position((last_used_position - 1) - (last_position_hash_factor / 2));
-	int upper_halfway_position = get_position_in_entry(upper_halfway);
-	int lower_halfway = normalize_position((last_used_position - 1) + (last_position_hash_factor / 2));
-	int lower_halfway_position = get_position_in_entry(lower_halfway);
+	int upper_halfway_position = entries[normalize_position(last_used_entry - (last_position_hash_factor / 2))];
+	int lower_halfway_position = entries[normalize_position(last_used_entry + (last_position_hash_factor / 2))];
 
 	// Si está el mismo número, cosas mágicas ocurren
 	if (lower_halfway_position == upper_halfway_position) {
@@ -174,7 +208,7 @@ std::pair<bool, int> hash_table<K>::try_position_erasure(int last_position_hash_
 		// a la que apuntaba la última accedida para que apunten a lo que
 		// apuntan las dos mitades hacia arriba y hacia abajo
 		for (int i = 0; i < get_size() / last_position_hash_factor; i++)
-			set_position_in_entry((last_used_position - 1) + last_position_hash_factor * i, lower_halfway_position);
+			entries[normalize_position(last_used_entry + last_position_hash_factor * i)] = lower_halfway_position;
 
 		// Intentamos achicar la tabla si las mitades superior e inferior
 		// son iguales
@@ -191,61 +225,46 @@ std::pair<bool, int> hash_table<K>::try_position_erasure(int last_position_hash_
 }
 
 template<typename K>
-hash_table<K>::~hash_table() {
-	file.write_block(0, control_block);
+void hash_table<K>::checkpoint() {
+	std::ofstream file(filename.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+
+	// El archivo queda igual que si cada entrada fuera un bloque
+	// de sizeof(int) precedido por un bloque de control con el tamaño
+	int size = get_size();
+	file.write(reinterpret_cast<const char *>(&size), sizeof(int));
+	file.write(reinterpret_cast<const char *>(&entries[0]), size * sizeof(int));
+	file.close();
+	if (!file)
+		throw commons::io::ioexception("Could not save the hash table in '" + filename + "'");
 }
 
 template<typename K>
-void hash_table<K>::block_file_initializer::initialize(commons::io::block_file *file) const {
-	commons::io::block b(file->get_block_size());
-
-	// Guardo el bloque de control
-	commons::io::serialize(1, &b, 0);
-	file->append_block(b);
-
-	// Guardo un primer bloque para que todas las claves apunten
-	// a la posición cero
-	commons::io::serialize(0, &b, 0);
-	file->append_block(b);
-}
-
-template<typename K>
-int hash_table<K>::do_hash(const K &key) const{
-	return (key % get_size()) + 1;
-}
-
-template<typename K>
-void hash_table<K>::set_size(int size) {
-	commons::io::serialize(size, &control_block, 0);
+void hash_table<K>::close() {
+	if (writable) {
+		checkpoint();
+		writable = false;
+	}
 }
 
 template<typename K>
-int hash_table<K>::get_position_in_entry(int entry) {
-	commons::io::block b = file.read_block(entry + 1);
-	return commons::io::deserialize<int>(b, 0);
-}
+hash_table<K>::~hash_table() {
+	try {
+		close();
+	} catch (commons::io::ioexception &e) {
 
-template<typename K>
-void hash_table<K>::set_position_in_entry(int entry, int position) {
-	commons::io::block b(file.get_block_size());
-	commons::io::serialize(position, &b, 0);
-	file.write_block(entry + 1, b);
+	}
 }
 
 template<typename K>
 void hash_table<K>::shrink_if_possible() {
 	// Chequeo la mitad inferior contra la mitad superior.
 	int half_size = get_size() / 2;
-	for (int i = 0; i < half_size; i++) {
-		// Si alguna de las posiciones no corresponde, salimos
-		if (get_position_in_entry(i) != get_position_in_entry(i + half_size)) {
-			return;
-		}
-	}
+	if (std::memcmp(&entries[0], &entries[half_size], half_size * sizeof(int)) != 0)
+		return;
 
 	// Si llegamos acá, todas las posiciónes de la mitad inferior eran
 	// iguales a las de la mitad superior. Achicamos la tabla a la mitad
-	set_size(half_size);
+	entries.resize(half_size);
 }
 
 template<typename K>
@@ -259,13 +278,5 @@ int hash_table<K>::normalize_position(int position) {
 	return position;
 }
 
-inline int operator %(const std::string &key, int max) {
-     unsigned int h = 0;
-     for(std::string::size_type i = 0; i < key.size(); i++) {
-		 h = 31 * h + key[i];
-     }
-     return h % max;
-}
-
 };
 #endif // __HASH_HASH_TABLE_H_INCLUDED__
@@ -0,0 +1,278 @@
+/******************************************************************************
+ * overlay_container.h
+ * 		Declaraciones y definiciones de la clase overlay::overlay_container
+******************************************************************************/
+#ifndef __OVERLAY_OVERLAY_CONTAINER_H_INCLUDED__
+#define __OVERLAY_OVERLAY_CONTAINER_H_INCLUDED__
+
+#include "../associative_container.h"
+#include <set>
+#include <vector>
+#include <utility>
+#include <iostream>
+
+namespace overlay {
+
+/**
+ * Contenedor que agrega una capa de cambios sobre un contenedor
+ * base que nunca se modifica (copy-on-write). Las búsquedas
+ * se resuelven primero en la capa de cambios y, si la clave no
+ * está ahí, en la base. Las modificaciones se guardan siempre
+ * en la capa de cambios, aunque el elemento venga de la base.
+ *
+ * Los elementos de la base que se eliminan se recuerdan en
+ * memoria, para no volver a encontrarlos en la base.
+ *
+ * El contenedor no toma posesión de ninguna de las dos capas;
+ * quien lo crea es responsable de liberarlas.
+ */
+template<typename K, typename T>
+class overlay_container : public container::associative_container<K, T> {
+private:
+	typedef container::associative_container<K, T> parent;
+
+	parent *base;
+	parent *delta;
+	std::set<K> deleted;
+
+	// Claves que no se encontraron en la capa de cambios en la
+	// búsqueda por lotes actual, y su posición en el lote
+	std::vector<K> pending_keys;
+	std::vector<unsigned int> pending_hashes;
+	std::vector<typename std::vector<K>::size_type> pending_positions;
+	std::vector<typename parent::search_result_type> pending_results;
+
+	bool is_deleted(const K &key) const;
+	void collect_missing(const std::vector<K> &keys, const std::vector<unsigned int> *hashes, const std::vector<typename parent::search_result_type> &results);
+	void restore(const std::vector<K> &keys);
+public:
+	/**
+	 * Crea un nuevo overlay_container con los elementos de base,
+	 * que guarda todas las modificaciones en delta
+	 */
+	overlay_container(parent *base, parent *delta);
+
+	/**
+	 * Agrega un elemento al contenedor. Valida si el
+	 * elemento está en el contenedor, en cuyo caso eleva
+	 * duplicate_exception.
+	 */
+	void add_element(const K &key, const T &value);
+
+	/**
+	 * Modifica un elemento existente en el contenedor.
+	 * Valida que el elemento exista, en caso contrario
+	 * eleva not_found_exception
+	 */
+	void update_element(const K &key, const T &value);
+
+	/**
+	 * Modifica un elemento si existe en el contenedor, o
+	 * lo agrega en caso contrario.
+	 */
+	void upsert_element(const K &key, const T &value);
+
+	/**
+	 * Elimina un elemento existente en el contenedor.
+	 * Valida que el elemento exista, en caso contrario
+	 * eleva not_found_exception
+	 */
+	void delete_element(const K &key);
+
+	/**
+	 * Busca un elemento en el contenedor. Si el elemento
+	 * existe, result.first será true, y result.second será
+	 * una copia del elemento almacenado. En caso contrario,
+	 * result.first será false.
+	 */
+	typename parent::search_result_type search_for_element(const K &key);
+
+	/**
+	 * Override de associative_container::search_for_elements.
+	 * Busca el lote en la capa de cambios, y sólo las claves
+	 * que faltan en la base.
+	 */
+	virtual void search_for_elements(const std::vector<K> &keys, std::vector<typename parent::search_result_type> &results);
+
+	/**
+	 * Override de associative_container::upsert_elements
+	 */
+	virtual void upsert_elements(const std::vector<K> &keys, const std::vector<T> &values);
+
+	/**
+	 * Override de associative_container::search_for_hashed_elements
+	 */
+	virtual void search_for_hashed_elements(const std::vector<K> &keys, const std::vector<unsigned int> &hashes, std::vector<typename parent::search_result_type> &results);
+
+	/**
+	 * Override de associative_container::upsert_hashed_elements
+	 */
+	virtual void upsert_hashed_elements(const std::vector<K> &keys, const std::vector<unsigned int> &hashes, const std::vector<T> &values);
+
+	/**
+	 * Vuelca el contenido de las dos capas en un stream dado.
+	 */
+	virtual void dump_to_stream(std::ostream &output);
+
+	/**
+	 * Inspecciona todos los pares clave-valor almacenados en
+	 * el contenedor asociativo utilizando la interface de inspección
+	 * dada
+	 */
+	virtual void inspect(container::element_inspector<K, T> &inspector);
+};
+
+template<typename K, typename T>
+overlay_container<K, T>::overlay_container(parent *base, parent *delta)
+: base(base), delta(delta) {
+
+}
+
+template<typename K, typename T>
+void overlay_container<K, T>::add_element(const K &key, const T &value) {
+	if (search_for_element(key).first)
+		throw typename parent::duplicate_exception();
+
+	delta->add_element(key, value);
+	deleted.erase(key);
+}
+
+template<typename K, typename T>
+void overlay_container<K, T>::update_element(const K &key, const T &value) {
+	if (!search_for_element(key).first)
+		throw typename parent::not_found_exception();
+
+	delta->upsert_element(key, value);
+}
+
+template<typename K, typename T>
+void overlay_container<K, T>::upsert_element(const K &key, const T &value) {
+	delta->upsert_element(key, value);
+	deleted.erase(key);
+}
+
+template<typename K, typename T>
+void overlay_container<K, T>::delete_element(const K &key) {
+	if (!search_for_element(key).first)
+		throw typename parent::not_found_exception();
+
+	// Si sólo estaba en la capa de cambios alcanza con borrarlo
+	// de ahí; si no, hay que ocultar el de la base
+	if (delta->search_for_element(key).first)
+		delta->delete_element(key);
+	if (base->search_for_element(key).first)
+		deleted.insert(key);
+}
+
+template<typename K, typename T>
+typename overlay_container<K, T>::parent::search_result_type overlay_container<K, T>::search_for_element(const K &key) {
+	typename parent::search_result_type result = delta->search_for_element(key);
+	if (result.first || is_deleted(key))
+		return result;
+
+	return base->search_for_element(key);
+}
+
+template<typename K, typename T>
+void overlay_container<K, T>::search_for_elements(const std::vector<K> &keys, std::vector<typename parent::search_result_type> &results) {
+	delta->search_for_elements(keys, results);
+	collect_missing(keys, NULL, results);
+	if (pending_positions.empty())
+		return;
+
+	base->search_for_elements(pending_keys, pending_results);
+	for (typename std::vector<K>::size_type i = 0; i < pending_positions.size(); i++)
+		results[pending_positions[i]] = pending_results[i];
+}
+
+template<typename K, typename T>
+void overlay_container<K, T>::upsert_elements(const std::vector<K> &keys, const std::vector<T> &values) {
+	delta->upsert_elements(keys, values);
+	restore(keys);
+}
+
+template<typename K, typename T>
+void overlay_container<K, T>::search_for_hashed_elements(const std::vector<K> &keys, const std::vector<unsigned int> &hashes, std::vector<typename parent::search_result_type> &results) {
+	delta->search_for_hashed_elements(keys, hashes, results);
+	collect_missing(keys, &hashes, results);
+	if (pending_positions.empty())
+		return;
+
+	base->search_for_hashed_elements(pending_keys, pending_hashes, pending_results);
+	for (typename std::vector<K>::size_type i = 0; i < pending_positions.size(); i++)
+		results[pending_positions[i]] = pending_results[i];
+}
+
+template<typename K, typename T>
+void overlay_container<K, T>::upsert_hashed_elements(const std::vector<K> &keys, const std::vector<unsigned int> &hashes, const std::vector<T> &values) {
+	delta->upsert_hashed_elements(keys, hashes, values);
+	restore(keys);
+}
+
+template<typename K, typename T>
+void overlay_container<K, T>::dump_to_stream(std::ostream &output) {
+	output << "CONTENEDOR EN CAPAS" << std::endl;
+	output << "---------- -- -----" << std::endl;
+	output << "Elementos eliminados de la base: " << deleted.size() << std::endl;
+	output << "---Cambios---: " << std::endl;
+	delta->dump_to_stream(output);
+	output << "---Base---: " << std::endl;
+	base->dump_to_stream(output);
+}
+
+template<typename K, typename T>
+void overlay_container<K, T>::inspect(container::element_inspector<K, T> &inspector) {
+	// Inspecciona los elementos de la base que no fueron
+	// modificados ni eliminados
+	struct base_filter : public container::element_inspector<K, T> {
+		overlay_container<K, T> &owner;
+		container::element_inspector<K, T> &inspector;
+
+		base_filter(overlay_container<K, T> &owner, container::element_inspector<K, T> &inspector)
+		: owner(owner), inspector(inspector) {}
+
+		virtual void inspect(const K &key, const T &value) {
+			if (!owner.is_deleted(key) && !owner.delta->search_for_element(key).first)
+				inspector.inspect(key, value);
+		}
+	};
+
+	delta->inspect(inspector);
+
+	base_filter filter(*this, inspector);
+	base->inspect(filter);
+}
+
+template<typename K, typename T>
+bool overlay_container<K, T>::is_deleted(const K &key) const {
+	return !deleted.empty() && deleted.count(key) > 0;
+}
+
+template<typename K, typename T>
+void overlay_container<K, T>::collect_missing(const std::vector<K> &keys, const std::vector<unsigned int> *hashes, const std::vector<typename parent::search_result_type> &results) {
+	pending_keys.clear();
+	pending_hashes.clear();
+	pending_positions.clear();
+	for (typename std::vector<K>::size_type i = 0; i < keys.size(); i++) {
+		if (results[i].first || is_deleted(keys[i]))
+			continue;
+
+		pending_keys.push_back(keys[i]);
+		if (hashes)
+			pending_hashes.push_back((*hashes)[i]);
+		pending_positions.push_back(i);
+	}
+}
+
+template<typename K, typename T>
+void overlay_container<K, T>::restore(const std::vector<K> &keys) {
+	if (deleted.empty())
+		return;
+
+	for (typename std::vector<K>::size_type i = 0; i < keys.size(); i++)
+		deleted.erase(keys[i]);
+}
+
+};
+
+#endif // __OVERLAY_OVERLAY_CONTAINER_H_INCLUDED__
@@ -3,12 +3,13 @@
  * 		Definiciones de la clase ppmc::compressor
 ******************************************************************************/
 #include "compressor.h"
+#include "../commons/log/log.h"
 
 using namespace ppmc;
 using namespace std;
 
 compressor::compressor(commons::io::binary_destination &destination, int max_contexts, context_container *container)
-: arithmetic_compressor(destination), context_default(arithmetic::symbol::SEOF), buffer(max_contexts), container(container) {
+: arithmetic_compressor(destination), context_default(arithmetic::symbol::SEOF), buffer(max_contexts), distribution_cache(max_contexts), container(container) {
 	// Inicializamos el contexto equiprobable default con todos los chars posibles
 	for (unsigned int c = 0; c < 256; c++) {
 		context_default.register_symbol_emision(arithmetic::symbol::for_char(c));
@@ -18,27 +19,38 @@ compressor::compressor(commons::io::binary_destination &destination, int max_con
 void compressor::compress(commons::io::char_source &source) {
 	LOG_DEBUG("Start Compression with ppmc");
 
-	std::pair<bool, unsigned char> char_extraction = source.get_next_char();
+	// Si el contenedor ya tiene un modelo, se parte de él
+	distribution_cache.load_context_zero(*container, context_zero);
 
-	// Procesar cada char individualmente
-	while (char_extraction.first) {
-		LOG_DEBUG_VAR(arithmetic::symbol::for_char(char_extraction.second));
-		process_char(arithmetic::symbol::for_char(char_extraction.second));
-		char_extraction = source.get_next_char();
+	// Leo el origen de a tramos y proceso cada char del tramo
+	std::vector<unsigned char> chars(CHAR_STREAM_BUFFER_SIZE);
+	std::size_t count = source.read(&chars[0], chars.size());
+	while (count > 0) {
+		for (std::size_t i = 0; i < count; i++) {
+			LOG_DEBUG_VAR(arithmetic::symbol::for_char(chars[i]));
+			process_char(arithmetic::symbol::for_char(chars[i]));
+		}
+		count = source.read(&chars[0], chars.size());
 	}
 
 	// Por último, emitir el eof y terminar
 	process_char(arithmetic::symbol::SEOF);
 	arithmetic_compressor.finish_compression();
+
+	// El modelo queda completo en el contenedor, por ejemplo
+	// para usarlo como diccionario
+	distribution_cache.store_context_zero(*container, context_zero);
 }
 
 void compressor::process_char(const arithmetic::symbol &c) {
 	LOG_DEBUG("Process char");
 	LOG_DEBUG_VAR(c.get_sequential_code());
 	LOG_DEBUG_VAR(static_cast<int>(buffer.max_context()));
-	distribution_cache = new arithmetic::symbol_distribution[buffer.max_context()];
 	arithmetic::symbol_distribution::exclusion_set exclusion;
 
+	// Cargo de una vez las distribuciones de todos los contextos
+	distribution_cache.load(buffer, *container);
+
 	// Indica en que contexto se emitió el char
 	int matching_context = search_for_match_in_contexts(c, exclusion);
 
@@ -65,8 +77,6 @@ void compressor::process_char(const arithmetic::symbol &c) {
 
 		buffer.push_char(c.get_char_code());
 	}
-
-	delete[] distribution_cache;
 }
 
 int compressor::search_for_match_in_contexts(const arithmetic::symbol &c, arithmetic::symbol_distribution::exclusion_set &exclusion) {
@@ -76,17 +86,7 @@ int compressor::search_for_match_in_contexts(const arithmetic::symbol &c, arithm
 	// en el contenedor asociativo
 	for (int i = static_cast<int>(buffer.max_context()) - 1; i >= 0; i--) {
 		LOG_DEBUG("Context:");
-		LOG_DEBUG_VAR(buffer.get_context(i+1));
-		// Busco el contexto en el contenedor persistente de contextos
-		std::pair<bool, arithmetic::symbol_distribution> search_result = container->search_for_element(buffer.get_context(i+1));
-		// Si está, la copio en la lista de distribuciones a actualizar
-		// sino genero una distribución nueva
-		if (search_result.first) {
-			distribution_cache[i] = search_result.second;
-		} else {
-			distribution_cache[i] = arithmetic::symbol_distribution();
-		}
-
+		LOG_DEBUG_VAR(distribution_cache.get_context(i));
 		LOG_DEBUG("Distribution before compressing");
 		LOG_DEBUG_VAR(distribution_cache[i]);
 
@@ -96,14 +96,14 @@ int compressor::search_for_match_in_contexts(const arithmetic::symbol &c, arithm
 		if (matching_context == -1) {
 			if (distribution_cache[i].has_symbol(c)) {
 				// Encontramos una distribución que contiene el símbolo!
-				arithmetic::symbol_distribution excluded_distribution = distribution_cache[i].exclude(exclusion);
+				arithmetic::symbol_distribution::excluded_view excluded_distribution = distribution_cache[i].exclude(exclusion);
 				arithmetic_compressor.compress(c, excluded_distribution);
 				matching_context = i + 1;
 				LOG_DEBUG("Matcheo en el contexto!!");
 				LOG_DEBUG_VAR(matching_context);
 			} else {
 				// Emitimos un escape en este contexto
-				arithmetic::symbol_distribution excluded_distribution = distribution_cache[i].exclude(exclusion);
+				arithmetic::symbol_distribution::excluded_view excluded_distribution = distribution_cache[i].exclude(exclusion);
 				arithmetic_compressor.compress(arithmetic::symbol::ESC, excluded_distribution);
 				distribution_cache[i].append_to_exclusion_set(exclusion);
 				LOG_DEBUG("Emito ESC");
@@ -119,12 +119,12 @@ int compressor::search_for_match_in_context_zero(const arithmetic::symbol &c, ar
 	int matching_context = -1;
 	LOG_DEBUG_VAR(context_zero);
 	if (context_zero.has_symbol(c)) {
-		arithmetic::symbol_distribution excluded_distribution = context_zero.exclude(exclusion);
+		arithmetic::symbol_distribution::excluded_view excluded_distribution = context_zero.exclude(exclusion);
 		arithmetic_compressor.compress(c, excluded_distribution);
 		matching_context = 0;
 		LOG_DEBUG("Matching in context Zero!!!");
 	} else {
-		arithmetic::symbol_distribution excluded_distribution = context_zero.exclude(exclusion);
+		arithmetic::symbol_distribution::excluded_view excluded_distribution = context_zero.exclude(exclusion);
 		arithmetic_compressor.compress(arithmetic::symbol::ESC, excluded_distribution);
 		context_zero.append_to_exclusion_set(exclusion);
 		LOG_DEBUG("Emito ESC");
@@ -156,10 +156,8 @@ void compressor::update_char_emissions(unsigned char c) {
 	for (unsigned int i = 0; i < buffer.max_context(); i++) {
 		LOG_DEBUG_VAR(i);
 		distribution_cache[i].register_symbol_emision(arithmetic::symbol::for_char(c));
-		try {
-			container->update_element(buffer.get_context(i+1), distribution_cache[i]);
-		} catch (context_container::not_found_exception &not_found_exception) {
-			container->add_element(buffer.get_context(i+1),distribution_cache[i]);
-		}
 	}
+
+	// Guardo todos los contextos de una vez
+	distribution_cache.store(*container);
 }
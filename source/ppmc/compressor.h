@@ -8,10 +8,13 @@
 
 #include "../commons/io/char_source.h"
 #include "../commons/io/binary_destination.h"
-#include "../arithmetic/compressor.h"
+#include "../arithmetic/range_compressor.h"
 #include "../config/config.h"
 #include "context_buffer.h"
+#include "distribution_arena.h"
 #include "../associative_container.h"
+#include <vector>
+#include <string>
 
 namespace ppmc {
 
@@ -20,12 +23,12 @@ namespace ppmc {
  */
 class compressor {
 private:
-	typedef container::associative_container<std::string, arithmetic::symbol_distribution> context_container;
-	arithmetic::compressor<ARITHMETIC_COMPRESSOR_PRECISION> arithmetic_compressor;
+	typedef distribution_arena::context_container context_container;
+	arithmetic::range_compressor arithmetic_compressor;
 	arithmetic::symbol_distribution context_zero;
 	arithmetic::symbol_distribution context_default;
-	arithmetic::symbol_distribution *distribution_cache;
 	context_buffer buffer;
+	distribution_arena distribution_cache;
 	context_container *container;
 
 	void process_char(const arithmetic::symbol &c);
@@ -3,43 +3,54 @@
  * 		Definiciones de la clase ppmc::context_buffer
 ******************************************************************************/
 #include "context_buffer.h"
+#include "../commons/utils/hash_utils.h"
 
 using namespace ppmc;
 
 context_buffer::context_buffer(unsigned int max_size)
-: max_size(max_size), buffer_start_position(0) {
-
+: window(2 * max_size), max_size(max_size), size(0), next_position(0), suffix_states(max_size + 1) {
+	suffix_states[0] = commons::utils::hashing::initial_state;
 }
 
 void context_buffer::push_char(unsigned char c) {
-	if (buffer.size() < max_size) {
-		buffer += c;
-	} else {
-		buffer[buffer_start_position] = c;
-		buffer_start_position++;
-		buffer_start_position %= max_size;
+	if (max_size == 0)
+		return;
+
+	// Escribo el char en su posición y en su espejo
+	window[next_position] = c;
+	window[next_position + max_size] = c;
+	next_position = (next_position + 1) % max_size;
+	if (size < max_size)
+		size++;
+
+	// El contexto de orden k es el contexto anterior de orden
+	// k - 1 seguido de c, así que actualizo de mayor a menor
+	for (unsigned int k = size; k > 0; k--) {
+		suffix_states[k] = commons::utils::hashing::extend_state(suffix_states[k - 1], c);
 	}
 }
 
 bool context_buffer::has_context(unsigned int context_size) const {
-	return buffer.size() >= context_size;
+	return size >= context_size;
 }
 
 unsigned int context_buffer::max_context() const {
-	return buffer.size();
+	return size;
 }
 
 std::string context_buffer::get_context(unsigned int context_size) const {
-	std::string result;
-
-	for (std::string::size_type i = buffer_start_position + buffer.size() - context_size; i < buffer.size(); i++) {
-		result += buffer[i];
-	}
+	return get_context_view(context_size).str();
+}
 
-	int actual_start_position = ((int)buffer_start_position - (int)context_size < 0) ? 0 : buffer_start_position - context_size;
-	for (std::string::size_type i = actual_start_position; i < buffer_start_position; i++) {
-		result += buffer[i];
-	}
+context_buffer::context_view context_buffer::get_context_view(unsigned int context_size) const {
+	// El último char está en next_position - 1 + max_size, y
+	// los context_size chars anteriores están contiguos
+	context_view view;
+	view.data = window.empty() ? 0 : &window[0] + next_position + max_size - context_size;
+	view.size = context_size;
+	return view;
+}
 
-	return result;
+unsigned int context_buffer::get_context_hash(unsigned int context_size) const {
+	return commons::utils::hashing::finish_state(suffix_states[context_size]);
 }
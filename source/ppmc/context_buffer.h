@@ -6,18 +6,43 @@
 #define __PPMC_CONTEXT_BUFFER_H_INCLUDED__
 
 #include <string>
+#include <vector>
 
 namespace ppmc {
 
 /**
- * Representa un buffer de los últimos n chars
+ * Representa un buffer de los últimos n chars.
+ *
+ * Internamente es un buffer circular espejado: cada char se
+ * escribe en su posición y en la misma posición n chars más
+ * adelante, de manera que cualquier contexto queda contiguo
+ * en memoria y se puede obtener sin copiarlo.
  */
 class context_buffer {
 private:
-	std::string buffer;
+	std::vector<char> window;
 	unsigned int max_size;
-	unsigned int buffer_start_position;
+	unsigned int size;
+	unsigned int next_position;
+
+	// suffix_states[k] es el estado del hash del contexto de
+	// orden k, que se actualiza con cada char agregado
+	std::vector<unsigned int> suffix_states;
 public:
+	/**
+	 * Vista de sólo lectura sobre un contexto del buffer. Sólo
+	 * es válida hasta el próximo push_char.
+	 */
+	struct context_view {
+		const char *data;
+		unsigned int size;
+
+		/**
+		 * Copia el contexto a un string
+		 */
+		std::string str() const { return std::string(data, size); }
+	};
+
 	/**
 	 * Crea una nueva instancia de context_buffer
 	 * que almacenará hasta el contexto de tamaño
@@ -49,6 +74,18 @@ public:
 	 */
 	std::string get_context(unsigned int context_size) const;
 
+	/**
+	 * Obtiene una vista del contexto de orden context_size
+	 * del buffer, sin copiarlo
+	 */
+	context_view get_context_view(unsigned int context_size) const;
+
+	/**
+	 * Obtiene el hash del contexto de orden context_size,
+	 * que es igual a commons::utils::hashing::hash_string
+	 * aplicado a get_context(context_size)
+	 */
+	unsigned int get_context_hash(unsigned int context_size) const;
 };
 
 };
@@ -0,0 +1,64 @@
+/******************************************************************************
+ * context_container_factory.h
+ * 		Declaraciones de la clase ppmc::context_container_factory
+******************************************************************************/
+#ifndef __PPMC_CONTEXT_CONTAINER_FACTORY_H_INCLUDED__
+#define __PPMC_CONTEXT_CONTAINER_FACTORY_H_INCLUDED__
+
+#include "distribution_arena.h"
+#include "../commons/io/ioexception.h"
+#include "../commons/io/open_mode.h"
+#include <string>
+
+namespace ppmc {
+
+/**
+ * Interface de una fábrica de contenedores de contextos vacíos.
+ * Permite crear un contenedor independiente para cada compresión,
+ * por ejemplo para cada segmento de una compresión en paralelo.
+ */
+class context_container_factory {
+public:
+	typedef distribution_arena::context_container context_container;
+
+	/**
+	 * Crea un nuevo contenedor de contextos vacío, que no comparte
+	 * estado con ningún otro contenedor creado por la fábrica
+	 */
+	virtual context_container *create_container() = 0;
+
+	/**
+	 * Destruye un contenedor creado con create_container, liberando
+	 * los recursos (memoria, archivos) que utilice
+	 */
+	virtual void destroy_container(context_container *container) = 0;
+
+	/**
+	 * Abre el contenedor de contextos guardado en path. En modo
+	 * read_write lo crea vacío si no existe; en modo read_only
+	 * tiene que existir y no se modifica. A diferencia de los que
+	 * se crean con create_container, sus archivos se conservan al
+	 * destruirlo con destroy_container. Las fábricas que no guardan
+	 * sus contenedores en archivos elevan ioexception.
+	 */
+	virtual context_container *open_container(const std::string &path, commons::io::open_mode mode) {
+		throw commons::io::ioexception("This kind of context container can not be stored in '" + path + "'");
+	}
+
+	/**
+	 * Reescribe el contenedor guardado en path, que no tiene que
+	 * estar abierto, en la forma más compacta que permita su
+	 * formato. Se usa cuando el contenedor ya no va a cambiar, por
+	 * ejemplo al terminar de entrenar un diccionario. Por omisión
+	 * lo deja como está.
+	 */
+	virtual void compact_container(const std::string &path) {
+
+	}
+
+	virtual ~context_container_factory() {}
+};
+
+};
+
+#endif
@@ -9,7 +9,7 @@
 using namespace ppmc;
 
 decompressor::decompressor(commons::io::binary_source &source, int max_contexts, context_container *container)
-: arithmetic_decompressor(source), context_default(arithmetic::symbol::SEOF), buffer(max_contexts), container(container) {
+: arithmetic_decompressor(source), context_default(arithmetic::symbol::SEOF), buffer(max_contexts), distribution_cache(max_contexts), container(container) {
 	// Inicializamos el contexto equiprobable default con todos los chars posibles
 	for (unsigned int c = 0; c < 256; c++) {
 		context_default.register_symbol_emision(arithmetic::symbol::for_char(c));
@@ -17,26 +17,24 @@ decompressor::decompressor(commons::io::binary_source &source, int max_contexts,
 }
 
 void decompressor::decompress(commons::io::char_destination &destination) {
+	// Los chars descomprimidos se juntan en un tramo que se
+	// emite de una vez al destino
+	std::vector<unsigned char> chars;
+	chars.reserve(CHAR_STREAM_BUFFER_SIZE);
+
+	// Si el contenedor ya tiene un modelo, se parte de él
+	distribution_cache.load_context_zero(*container, context_zero);
 
 	while (true) {
-		distribution_cache = new arithmetic::symbol_distribution[buffer.max_context()];
 		arithmetic::symbol_distribution::exclusion_set exclusion;
 
 		unsigned char matching_char = 0;
 		int matching_context = -1;
+		// Cargo de una vez las distribuciones de todos los contextos
+		distribution_cache.load(buffer, *container);
 		for (int i = static_cast<int>(buffer.max_context()) - 1; i >= 0; i--) {
-			std::pair<bool, arithmetic::symbol_distribution> result = container->search_for_element(buffer.get_context(i+1));
-
-			if (result.first) {
-				//Utilizo la distribución del contenedor
-				distribution_cache[i] = result.second;
-			} else {
-				//Creo una nueva distribución para ese contexto
-				distribution_cache[i] = arithmetic::symbol_distribution();
-			}
-
 			if (matching_context == -1) {
-				arithmetic::symbol_distribution excluded_distribution = distribution_cache[i].exclude(exclusion);
+				arithmetic::symbol_distribution::excluded_view excluded_distribution = distribution_cache[i].exclude(exclusion);
 				arithmetic::symbol s = arithmetic_decompressor.decompress(excluded_distribution);
 				if (s != arithmetic::symbol::ESC) {
 					matching_char = s.get_char_code();
@@ -49,7 +47,7 @@ void decompressor::decompress(commons::io::char_destination &destination) {
 		}
 
 		if (matching_context == -1) {
-			arithmetic::symbol_distribution excluded_distribution = context_zero.exclude(exclusion);
+			arithmetic::symbol_distribution::excluded_view excluded_distribution = context_zero.exclude(exclusion);
 			arithmetic::symbol s = arithmetic_decompressor.decompress(excluded_distribution);
 			if (s != arithmetic::symbol::ESC) {
 				matching_char = s.get_char_code();
@@ -70,11 +68,19 @@ void decompressor::decompress(commons::io::char_destination &destination) {
 		update_esc_emissions(matching_context);
 		update_char_emissions(matching_char);
 
-		destination.emit_char(matching_char);
+		chars.push_back(matching_char);
+		if (chars.size() == CHAR_STREAM_BUFFER_SIZE) {
+			destination.write(&chars[0], chars.size());
+			chars.clear();
+		}
 		buffer.push_char(matching_char);
-		delete[] distribution_cache;
 	}
 
+	if (!chars.empty())
+		destination.write(&chars[0], chars.size());
+
+	// Igual que al comprimir, el modelo queda completo en el contenedor
+	distribution_cache.store_context_zero(*container, context_zero);
 }
 
 void decompressor::update_esc_emissions(int matching_context) {
@@ -92,10 +98,8 @@ void decompressor::update_char_emissions(unsigned char c) {
 	context_zero.register_symbol_emision(arithmetic::symbol::for_char(c));
 	for (unsigned int i = 0; i < buffer.max_context(); i++) {
 		distribution_cache[i].register_symbol_emision(arithmetic::symbol::for_char(c));
-		try {
-			container->update_element(buffer.get_context(i+1), distribution_cache[i]);
-		} catch (context_container::not_found_exception &not_found_exception) {
-			container->add_element(buffer.get_context(i+1),distribution_cache[i]);
-		}
 	}
+
+	// Guardo todos los contextos de una vez
+	distribution_cache.store(*container);
 }
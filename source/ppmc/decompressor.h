@@ -8,10 +8,13 @@
 
 #include "../commons/io/binary_source.h"
 #include "../commons/io/char_destination.h"
-#include "../arithmetic/decompresor.h"
+#include "../arithmetic/range_decompressor.h"
 #include "../config/config.h"
 #include "context_buffer.h"
+#include "distribution_arena.h"
 #include "../associative_container.h"
+#include <vector>
+#include <string>
 
 namespace ppmc {
 
@@ -20,12 +23,12 @@ namespace ppmc {
  */
 class decompressor {
 private:
-	typedef container::associative_container<std::string, arithmetic::symbol_distribution> context_container;
-	arithmetic::decompressor<ARITHMETIC_COMPRESSOR_PRECISION> arithmetic_decompressor;
+	typedef distribution_arena::context_container context_container;
+	arithmetic::range_decompressor arithmetic_decompressor;
 	arithmetic::symbol_distribution context_zero;
 	arithmetic::symbol_distribution context_default;
-	arithmetic::symbol_distribution *distribution_cache;
 	context_buffer buffer;
+	distribution_arena distribution_cache;
 	context_container *container;
 
 	void update_esc_emissions(int matching_context);
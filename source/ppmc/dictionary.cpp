@@ -0,0 +1,27 @@
+/******************************************************************************
+ * dictionary.cpp
+ * 		Definiciones de las funciones de ppmc::dictionary
+******************************************************************************/
+#include "dictionary.h"
+#include "compressor.h"
+#include "../commons/io/binary_destination.h"
+
+namespace {
+
+/**
+ * Destino que descarta los bits emitidos; al entrenar sólo
+ * interesa el modelo que queda en el contenedor
+ */
+struct discarding_destination : public commons::io::binary_destination {
+	virtual void emit_bit(bool bit) {}
+
+	virtual void emit_bits(uint64_t value, int count) {}
+};
+
+};
+
+void ppmc::dictionary::train(commons::io::char_source &corpus, int max_contexts, distribution_arena::context_container *container) {
+	discarding_destination destination;
+	compressor trainer(destination, max_contexts, container);
+	trainer.compress(corpus);
+}
@@ -0,0 +1,40 @@
+/******************************************************************************
+ * dictionary.h
+ * 		Declaraciones de las funciones de ppmc::dictionary
+******************************************************************************/
+#ifndef __PPMC_DICTIONARY_H_INCLUDED__
+#define __PPMC_DICTIONARY_H_INCLUDED__
+
+#include "../commons/io/char_source.h"
+#include "distribution_arena.h"
+
+namespace ppmc {
+
+/**
+ * Un diccionario es un modelo de contextos entrenado de antemano
+ * con un corpus de textos parecidos a los que se van a comprimir
+ * (por ejemplo, logs con el mismo formato). Se guarda como un
+ * contenedor de contextos común, en el formato de archivo del
+ * contenedor que se use.
+ *
+ * Comprimir y descomprimir partiendo del diccionario en lugar de
+ * un modelo vacío evita aprender de nuevo los contextos en cada
+ * archivo, lo que mejora mucho la compresión de archivos chicos.
+ * El descompresor tiene que usar el mismo diccionario que el
+ * compresor.
+ */
+namespace dictionary {
+
+/**
+ * Entrena el modelo de contextos de container con los chars de
+ * corpus, con contextos de hasta max_contexts chars. El modelo
+ * evoluciona igual que al comprimir corpus, así que se puede
+ * llamar varias veces con el mismo container para entrenarlo
+ * con varios textos.
+ */
+void train(commons::io::char_source &corpus, int max_contexts, distribution_arena::context_container *container);
+
+};
+};
+
+#endif
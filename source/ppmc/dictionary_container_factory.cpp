@@ -0,0 +1,37 @@
+/******************************************************************************
+ * dictionary_container_factory.cpp
+ * 		Definiciones de la clase ppmc::dictionary_container_factory
+******************************************************************************/
+#include "dictionary_container_factory.h"
+#include "../overlay/overlay_container.h"
+
+using namespace ppmc;
+
+dictionary_container_factory::dictionary_container_factory(const std::string &path, context_container_factory &base_factory, context_container_factory &delta_factory)
+: path(path), base_factory(base_factory), delta_factory(delta_factory) {
+
+}
+
+context_container_factory::context_container *dictionary_container_factory::create_container() {
+	context_container *base = base_factory.open_container(path, commons::io::read_only);
+	context_container *delta;
+	try {
+		delta = delta_factory.create_container();
+	} catch (...) {
+		base_factory.destroy_container(base);
+		throw;
+	}
+
+	context_container *container = new overlay::overlay_container<std::string, arithmetic::symbol_distribution>(base, delta);
+	layers[container] = std::make_pair(base, delta);
+	return container;
+}
+
+void dictionary_container_factory::destroy_container(context_container *container) {
+	std::pair<context_container *, context_container *> layer = layers[container];
+	layers.erase(container);
+
+	delete container;
+	base_factory.destroy_container(layer.first);
+	delta_factory.destroy_container(layer.second);
+}
@@ -0,0 +1,59 @@
+/******************************************************************************
+ * dictionary_container_factory.h
+ * 		Declaraciones de la clase ppmc::dictionary_container_factory
+******************************************************************************/
+#ifndef __PPMC_DICTIONARY_CONTAINER_FACTORY_H_INCLUDED__
+#define __PPMC_DICTIONARY_CONTAINER_FACTORY_H_INCLUDED__
+
+#include "context_container_factory.h"
+#include <map>
+#include <string>
+#include <utility>
+
+namespace ppmc {
+
+/**
+ * Fábrica de contenedores de contextos que arrancan con el modelo
+ * de un diccionario (ver ppmc::dictionary). Cada contenedor es un
+ * overlay::overlay_container sobre el diccionario, abierto con
+ * base_factory, que guarda los cambios en un contenedor creado con
+ * delta_factory. El diccionario nunca se modifica, así que sirve
+ * para cualquier cantidad de compresiones.
+ *
+ * Cada contenedor abre el diccionario por separado en modo
+ * read_only, porque los contenedores no se pueden usar desde
+ * varios threads a la vez. Si el diccionario no existe, crear
+ * un contenedor eleva commons::io::ioexception. Como los archivos
+ * read_only se mapean a memoria, todos comparten las mismas
+ * páginas, incluso entre procesos, y abrirlo no copia el
+ * diccionario.
+ */
+class dictionary_container_factory : public context_container_factory {
+private:
+	std::string path;
+	context_container_factory &base_factory;
+	context_container_factory &delta_factory;
+
+	// Diccionario y cambios de cada contenedor creado
+	std::map<context_container *, std::pair<context_container *, context_container *> > layers;
+public:
+	/**
+	 * Crea una nueva fábrica de contenedores sobre el diccionario
+	 * guardado en path
+	 */
+	dictionary_container_factory(const std::string &path, context_container_factory &base_factory, context_container_factory &delta_factory);
+
+	/**
+	 * Override de context_container_factory::create_container
+	 */
+	virtual context_container *create_container();
+
+	/**
+	 * Override de context_container_factory::destroy_container
+	 */
+	virtual void destroy_container(context_container *container);
+};
+
+};
+
+#endif
@@ -0,0 +1,92 @@
+/******************************************************************************
+ * distribution_arena.cpp
+ * 		Definiciones de la clase ppmc::distribution_arena
+******************************************************************************/
+#include "distribution_arena.h"
+#include <algorithm>
+
+using namespace ppmc;
+
+distribution_arena::distribution_arena(unsigned int max_order) {
+	contexts.reserve(max_order);
+	context_hashes.reserve(max_order);
+	distributions.reserve(max_order);
+	pending_contexts.reserve(max_order);
+	pending_hashes.reserve(max_order);
+	pending_positions.reserve(max_order);
+	results.reserve(max_order);
+}
+
+void distribution_arena::load(const context_buffer &buffer, context_container &container) {
+	unsigned int loaded = contexts.size();
+	unsigned int count = buffer.max_context();
+
+	// Los lugares que hagan falta de más se agregan vacíos; como
+	// el buffer sólo crece, esto pasa únicamente con los primeros
+	// chars y nunca excede lo reservado
+	contexts.resize(count);
+	context_hashes.resize(count);
+	distributions.resize(count);
+
+	pending_contexts.clear();
+	pending_hashes.clear();
+	pending_positions.clear();
+	for (unsigned int i = 0; i < count; i++) {
+		context_buffer::context_view view = buffer.get_context_view(i + 1);
+		unsigned int hash = buffer.get_context_hash(i + 1);
+		if (i < loaded && is_loaded(i, view, hash))
+			continue;
+
+		contexts[i].assign(view.data, view.size);
+		context_hashes[i] = hash;
+		pending_contexts.push_back(contexts[i]);
+		pending_hashes.push_back(hash);
+		pending_positions.push_back(i);
+	}
+
+	if (pending_positions.empty())
+		return;
+
+	container.search_for_hashed_elements(pending_contexts, pending_hashes, results);
+	for (unsigned int i = 0; i < pending_positions.size(); i++) {
+		if (results[i].first) {
+			distributions[pending_positions[i]] = results[i].second;
+		} else {
+			distributions[pending_positions[i]] = arithmetic::symbol_distribution();
+		}
+	}
+}
+
+void distribution_arena::store(context_container &container) {
+	container.upsert_hashed_elements(contexts, context_hashes, distributions);
+}
+
+void distribution_arena::load_context_zero(context_container &container, arithmetic::symbol_distribution &context_zero) {
+	context_container::search_result_type result = container.search_for_element(std::string());
+	if (result.first)
+		context_zero = result.second;
+}
+
+void distribution_arena::store_context_zero(context_container &container, const arithmetic::symbol_distribution &context_zero) {
+	container.upsert_element(std::string(), context_zero);
+}
+
+unsigned int distribution_arena::size() const {
+	return distributions.size();
+}
+
+const std::string &distribution_arena::get_context(unsigned int position) const {
+	return contexts[position];
+}
+
+arithmetic::symbol_distribution &distribution_arena::operator[](unsigned int position) {
+	return distributions[position];
+}
+
+bool distribution_arena::is_loaded(unsigned int position, const context_buffer::context_view &view, unsigned int hash) const {
+	// El hash descarta casi todos los contextos distintos sin
+	// tener que comparar los chars
+	return context_hashes[position] == hash
+		&& contexts[position].size() == view.size
+		&& std::equal(view.data, view.data + view.size, contexts[position].begin());
+}
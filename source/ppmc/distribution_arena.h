@@ -0,0 +1,95 @@
+/******************************************************************************
+ * distribution_arena.h
+ * 		Declaraciones de la clase ppmc::distribution_arena
+******************************************************************************/
+#ifndef __PPMC_DISTRIBUTION_ARENA_H_INCLUDED__
+#define __PPMC_DISTRIBUTION_ARENA_H_INCLUDED__
+
+#include "../arithmetic/symbol_distribution.h"
+#include "../associative_container.h"
+#include "context_buffer.h"
+#include <vector>
+#include <string>
+
+namespace ppmc {
+
+/**
+ * Espacio de trabajo de un compresor o descompresor PPMC con
+ * las distribuciones de los contextos de orden 1..N de la
+ * posición actual. Los lugares se reservan una sola vez, al
+ * crear la instancia, y se reutilizan para cada char.
+ *
+ * Si un contexto de la posición actual es el mismo que el del
+ * mismo orden en la posición anterior (por ejemplo, en una
+ * racha del mismo char), su distribución ya está cargada y
+ * actualizada, así que no se vuelve a buscar en el contenedor.
+ */
+class distribution_arena {
+public:
+	typedef container::associative_container<std::string, arithmetic::symbol_distribution> context_container;
+private:
+	std::vector<std::string> contexts;
+	std::vector<unsigned int> context_hashes;
+	std::vector<arithmetic::symbol_distribution> distributions;
+
+	// Contextos que hay que buscar en el contenedor en la
+	// carga actual, y su posición en la arena
+	std::vector<std::string> pending_contexts;
+	std::vector<unsigned int> pending_hashes;
+	std::vector<unsigned int> pending_positions;
+	std::vector<context_container::search_result_type> results;
+
+	bool is_loaded(unsigned int position, const context_buffer::context_view &view, unsigned int hash) const;
+public:
+	/**
+	 * Crea una nueva arena vacía con lugar para los
+	 * contextos de orden 1 hasta max_order
+	 */
+	distribution_arena(unsigned int max_order);
+
+	/**
+	 * Carga las distribuciones de todos los contextos disponibles
+	 * en buffer. Las que no están ya cargadas se buscan de una vez
+	 * en container; las que no están en container se reemplazan
+	 * por una distribución nueva.
+	 */
+	void load(const context_buffer &buffer, context_container &container);
+
+	/**
+	 * Guarda de una vez en container todas las distribuciones
+	 * cargadas
+	 */
+	void store(context_container &container);
+
+	/**
+	 * Carga en context_zero la distribución del contexto de orden
+	 * 0 guardada en container, si hay una (por ejemplo, si el
+	 * contenedor tiene un modelo entrenado). Se guarda con la
+	 * clave vacía, que no es la de ningún otro contexto.
+	 */
+	void load_context_zero(context_container &container, arithmetic::symbol_distribution &context_zero);
+
+	/**
+	 * Guarda en container la distribución del contexto de orden 0
+	 */
+	void store_context_zero(context_container &container, const arithmetic::symbol_distribution &context_zero);
+
+	/**
+	 * Devuelve la cantidad de contextos cargados
+	 */
+	unsigned int size() const;
+
+	/**
+	 * Devuelve el contexto de orden position + 1
+	 */
+	const std::string &get_context(unsigned int position) const;
+
+	/**
+	 * Devuelve la distribución del contexto de orden position + 1
+	 */
+	arithmetic::symbol_distribution &operator[](unsigned int position);
+};
+
+};
+
+#endif
@@ -0,0 +1,21 @@
+/******************************************************************************
+ * memory_container_factory.cpp
+ * 		Definiciones de la clase ppmc::memory_container_factory
+******************************************************************************/
+#include "memory_container_factory.h"
+#include "../trie/trie_container.h"
+
+using namespace ppmc;
+
+memory_container_factory::memory_container_factory(unsigned int memory_limit)
+: memory_limit(memory_limit) {
+
+}
+
+context_container_factory::context_container *memory_container_factory::create_container() {
+	return new trie::trie_container<arithmetic::symbol_distribution>(memory_limit);
+}
+
+void memory_container_factory::destroy_container(context_container *container) {
+	delete container;
+}
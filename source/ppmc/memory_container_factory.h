@@ -0,0 +1,40 @@
+/******************************************************************************
+ * memory_container_factory.h
+ * 		Declaraciones de la clase ppmc::memory_container_factory
+******************************************************************************/
+#ifndef __PPMC_MEMORY_CONTAINER_FACTORY_H_INCLUDED__
+#define __PPMC_MEMORY_CONTAINER_FACTORY_H_INCLUDED__
+
+#include "context_container_factory.h"
+
+namespace ppmc {
+
+/**
+ * Fábrica de contenedores de contextos en memoria, organizados
+ * como trie::trie_container. No crea archivos, y cada contenedor
+ * ocupa a lo sumo memory_limit bytes.
+ */
+class memory_container_factory : public context_container_factory {
+private:
+	unsigned int memory_limit;
+public:
+	/**
+	 * Crea una nueva fábrica de contenedores que no utilizarán
+	 * más de memory_limit bytes cada uno
+	 */
+	memory_container_factory(unsigned int memory_limit);
+
+	/**
+	 * Override de context_container_factory::create_container
+	 */
+	virtual context_container *create_container();
+
+	/**
+	 * Override de context_container_factory::destroy_container
+	 */
+	virtual void destroy_container(context_container *container);
+};
+
+};
+
+#endif
@@ -0,0 +1,134 @@
+/******************************************************************************
+ * segmented_compressor.cpp
+ * 		Definiciones de la clase ppmc::segmented_compressor
+******************************************************************************/
+#include "segmented_compressor.h"
+#include "segmented_format.h"
+#include "compressor.h"
+#include "../commons/io/memory_char_source.h"
+#include "../commons/io/stream_binary_destination.h"
+#include "../commons/io/ioexception.h"
+#include "../commons/utils/checksum_utils.h"
+#include "../config/config.h"
+#include <sstream>
+#include <vector>
+#include <deque>
+#include <algorithm>
+
+using namespace ppmc;
+
+namespace {
+
+/**
+ * Compresión de un segmento, con su propio contenedor
+ */
+struct compression_task : public commons::concurrency::task {
+	int max_contexts;
+	context_container_factory::context_container *container;
+	std::vector<unsigned char> input;
+	std::string output;
+	unsigned int checksum;
+
+	compression_task(int max_contexts, context_container_factory::context_container *container)
+	: max_contexts(max_contexts), container(container), checksum(0) {}
+
+	virtual void run() {
+		checksum = commons::utils::checksum::crc32(&input[0], input.size());
+
+		std::ostringstream output_stream(std::ios_base::out | std::ios_base::binary);
+		{
+			commons::io::memory_char_source source(&input[0], input.size());
+			commons::io::stream_binary_destination destination(output_stream);
+			compressor segment_compressor(destination, max_contexts, container);
+			segment_compressor.compress(source);
+		}
+		output = output_stream.str();
+	}
+};
+
+/**
+ * Llena buffer con hasta size chars de source, o hasta que source se
+ * termine. El buffer crece a medida que llegan los chars, para que
+ * una entrada chica no reserve un segmento entero.
+ */
+void read_segment(commons::io::char_source &source, std::vector<unsigned char> &buffer, unsigned int size) {
+	while (buffer.size() < size) {
+		std::size_t count = buffer.size();
+		std::size_t required = count + std::min<std::size_t>(size - count, CHAR_STREAM_BUFFER_SIZE);
+		if (buffer.capacity() < required)
+			buffer.reserve(std::min<std::size_t>(std::max(2 * buffer.capacity(), required), size));
+
+		buffer.resize(required);
+		std::size_t read = source.read(&buffer[count], required - count);
+		buffer.resize(count + read);
+		if (read == 0)
+			break;
+	}
+}
+
+};
+
+segmented_compressor::segmented_compressor(std::ostream &output, int max_contexts, unsigned int segment_size,
+	context_container_factory &factory, commons::concurrency::thread_pool &pool)
+: output(output), max_contexts(max_contexts), segment_size(segment_size), factory(factory), pool(pool) {
+
+}
+
+void segmented_compressor::compress(commons::io::char_source &source) {
+	segmented::write_header(output, segmented::header(max_contexts, segment_size));
+
+	// Se mantienen en vuelo a lo sumo dos segmentos por thread, para
+	// acotar la memoria sin dejar threads ociosos mientras se escribe
+	std::deque<compression_task *> pending;
+	std::deque<compression_task *>::size_type window = 2 * pool.get_thread_count();
+	std::string error;
+	bool finished = false;
+
+	// Posiciones de cada segmento, para el índice del final
+	segmented::segment_index segments;
+	uint64_t uncompressed_offset = 0;
+	uint64_t frame_offset = segmented::header_size;
+
+	while (!finished || !pending.empty()) {
+		if (!finished && pending.size() < window && error.empty()) {
+			compression_task *segment = new compression_task(max_contexts, factory.create_container());
+			read_segment(source, segment->input, segment_size);
+			if (segment->input.empty()) {
+				factory.destroy_container(segment->container);
+				delete segment;
+				finished = true;
+			} else {
+				pool.submit(segment);
+				pending.push_back(segment);
+			}
+			continue;
+		}
+
+		// Escribo el segmento más viejo cuando termina. Si uno falla
+		// dejo de leer, pero espero a los que están en vuelo
+		compression_task *segment = pending.front();
+		pending.pop_front();
+		pool.wait(segment);
+		if (segment->has_failed() && error.empty()) {
+			error = segment->get_error();
+		} else if (error.empty()) {
+			segmented::write_frame(output, segmented::frame(segment->input.size(), segment->output.size(), segment->checksum));
+			output.write(segment->output.data(), segment->output.size());
+
+			segments.push_back(segmented::index_entry(uncompressed_offset, frame_offset));
+			uncompressed_offset += segment->input.size();
+			frame_offset += segmented::frame_size + segment->output.size();
+		}
+		factory.destroy_container(segment->container);
+		delete segment;
+
+		if (!error.empty())
+			finished = true;
+	}
+
+	if (!error.empty())
+		throw commons::io::ioexception(error);
+
+	segmented::write_frame(output, segmented::frame());
+	segmented::write_index(output, segments, frame_offset + segmented::frame_size);
+}
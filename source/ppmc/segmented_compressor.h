@@ -0,0 +1,52 @@
+/******************************************************************************
+ * segmented_compressor.h
+ * 		Declaraciones de la clase ppmc::segmented_compressor
+******************************************************************************/
+#ifndef __PPMC_SEGMENTED_COMPRESSOR_H_INCLUDED__
+#define __PPMC_SEGMENTED_COMPRESSOR_H_INCLUDED__
+
+#include "../commons/io/char_source.h"
+#include "../commons/concurrency/thread_pool.h"
+#include "context_container_factory.h"
+#include <iostream>
+
+namespace ppmc {
+
+/**
+ * Compresor PPMC por segmentos. Divide la entrada en segmentos de
+ * tamaño fijo y comprime cada uno con un ppmc::compressor y un
+ * contenedor de contextos propios, en paralelo en un thread_pool.
+ * Los segmentos se escriben en orden en el formato descripto en
+ * segmented_format.h, seguidos del índice que permite descomprimir
+ * rangos sueltos.
+ *
+ * Como cada segmento empieza con un modelo vacío, la compresión es
+ * algo peor que la secuencial; la diferencia se reduce al agrandar
+ * los segmentos.
+ */
+class segmented_compressor {
+private:
+	std::ostream &output;
+	int max_contexts;
+	unsigned int segment_size;
+	context_container_factory &factory;
+	commons::concurrency::thread_pool &pool;
+public:
+	/**
+	 * Crea una nueva instancia de segmented_compressor que escribe
+	 * en output segmentos de segment_size chars, utilizando
+	 * contenedores de factory y los threads de pool
+	 */
+	segmented_compressor(std::ostream &output, int max_contexts, unsigned int segment_size,
+		context_container_factory &factory, commons::concurrency::thread_pool &pool);
+
+	/**
+	 * Comprime los chars que se obtienen desde source. Si falla la
+	 * compresión de algún segmento eleva commons::io::ioexception.
+	 */
+	void compress(commons::io::char_source &source);
+};
+
+};
+
+#endif
@@ -0,0 +1,174 @@
+/******************************************************************************
+ * segmented_decompressor.cpp
+ * 		Definiciones de la clase ppmc::segmented_decompressor
+******************************************************************************/
+#include "segmented_decompressor.h"
+#include "segmented_format.h"
+#include "decompressor.h"
+#include "../commons/io/memory_char_destination.h"
+#include "../commons/io/stream_binary_source.h"
+#include "../commons/io/ioexception.h"
+#include "../commons/utils/checksum_utils.h"
+#include "../config/config.h"
+#include <sstream>
+#include <vector>
+#include <deque>
+#include <limits>
+#include <algorithm>
+
+using namespace ppmc;
+
+namespace {
+
+/**
+ * Descompresión de un segmento, con su propio contenedor
+ */
+struct decompression_task : public commons::concurrency::task {
+	unsigned int number;
+	int max_contexts;
+	context_container_factory::context_container *container;
+	segmented::frame header;
+	std::string input;
+	std::vector<unsigned char> output;
+
+	decompression_task(unsigned int number, int max_contexts, context_container_factory::context_container *container)
+	: number(number), max_contexts(max_contexts), container(container) {}
+
+	virtual void run() {
+		output.reserve(header.uncompressed_size);
+		{
+			std::istringstream input_stream(input, std::ios_base::in | std::ios_base::binary);
+			commons::io::stream_binary_source source(input_stream);
+			commons::io::memory_char_destination destination(output);
+			decompressor segment_decompressor(source, max_contexts, container);
+			segment_decompressor.decompress(destination);
+		}
+
+		if (output.size() != header.uncompressed_size
+			|| commons::utils::checksum::crc32(output.empty() ? 0 : &output[0], output.size()) != header.checksum) {
+			std::stringstream error_description;
+			error_description << "Checksum mismatch in segment " << number;
+			throw commons::io::ioexception(error_description.str());
+		}
+	}
+};
+
+/**
+ * Lee los size chars comprimidos de un segmento en data. Se leen de
+ * a bloques, para que la memoria crezca con los datos que realmente
+ * hay y no con el tamaño que dice un frame posiblemente corrupto.
+ * Devuelve false si el stream termina antes.
+ */
+bool read_segment(std::istream &input, std::string &data, unsigned int size) {
+	while (data.size() < size) {
+		std::string::size_type read = data.size();
+		data.resize(read + std::min<std::string::size_type>(size - read, CHAR_STREAM_BUFFER_SIZE));
+		if (!input.read(&data[read], data.size() - read))
+			return false;
+	}
+	return true;
+}
+
+};
+
+segmented_decompressor::segmented_decompressor(std::istream &input, context_container_factory &factory, commons::concurrency::thread_pool &pool)
+: input(input), factory(factory), pool(pool) {
+
+}
+
+void segmented_decompressor::decompress(commons::io::char_destination &destination) {
+	segmented::header h = segmented::read_header(input);
+	decompress_segments(destination, h, 0, 0, std::numeric_limits<uint64_t>::max());
+}
+
+void segmented_decompressor::decompress_range(commons::io::char_destination &destination, uint64_t start, uint64_t length) {
+	segmented::header h = segmented::read_header(input);
+	segmented::segment_index segments = segmented::read_index(input);
+	if (segments.empty() || length == 0)
+		return;
+
+	// El primer segmento necesario es el último que empieza antes
+	// del rango; el primero empieza siempre en 0
+	segmented::segment_index::iterator first = std::upper_bound(segments.begin(), segments.end(), segmented::index_entry(start, 0));
+	first--;
+
+	input.clear();
+	input.seekg(first->frame_offset);
+	decompress_segments(destination, h, first - segments.begin(), start - first->uncompressed_offset, length);
+}
+
+void segmented_decompressor::decompress_segments(commons::io::char_destination &destination, const segmented::header &h,
+	unsigned int first_segment, uint64_t skip, uint64_t length) {
+	// Posición, a partir del comienzo del primer segmento, en la
+	// que termina el rango pedido
+	uint64_t range_end = length > std::numeric_limits<uint64_t>::max() - skip
+		? std::numeric_limits<uint64_t>::max() : skip + length;
+
+	std::deque<decompression_task *> pending;
+	std::deque<decompression_task *>::size_type window = 2 * pool.get_thread_count();
+	std::string error;
+	bool finished = false;
+	unsigned int segments = first_segment;
+	uint64_t submitted = 0;
+	uint64_t emitted = 0;
+
+	while (!finished || !pending.empty()) {
+		if (!finished && pending.size() < window && error.empty()) {
+			try {
+				segmented::frame f = segmented::read_frame(input);
+				if (f.is_end()) {
+					finished = true;
+					continue;
+				}
+
+				if (f.uncompressed_size > h.segment_size)
+					throw commons::io::ioexception("Corrupt segmented file frame");
+
+				decompression_task *segment = new decompression_task(segments++, h.max_contexts, factory.create_container());
+				segment->header = f;
+				if (!read_segment(input, segment->input, f.compressed_size)) {
+					factory.destroy_container(segment->container);
+					delete segment;
+					throw commons::io::ioexception("Truncated segmented file");
+				}
+
+				pool.submit(segment);
+				pending.push_back(segment);
+
+				// Los segmentos siguientes ya no tienen chars del rango
+				submitted += f.uncompressed_size;
+				if (submitted >= range_end)
+					finished = true;
+			} catch (commons::io::ioexception &e) {
+				error = e.what();
+				finished = true;
+			}
+			continue;
+		}
+
+		// Emito la parte del rango del segmento más viejo cuando
+		// termina. Si uno falla dejo de leer, pero espero a los que
+		// están en vuelo
+		decompression_task *segment = pending.front();
+		pending.pop_front();
+		pool.wait(segment);
+		if (segment->has_failed() && error.empty()) {
+			error = segment->get_error();
+		} else if (error.empty()) {
+			uint64_t size = segment->output.size();
+			uint64_t begin = std::min(size, skip > emitted ? skip - emitted : 0);
+			uint64_t end = std::min(size, range_end - emitted);
+			if (end > begin)
+				destination.write(&segment->output[begin], end - begin);
+			emitted += size;
+		}
+		factory.destroy_container(segment->container);
+		delete segment;
+
+		if (!error.empty())
+			finished = true;
+	}
+
+	if (!error.empty())
+		throw commons::io::ioexception(error);
+}
@@ -0,0 +1,59 @@
+/******************************************************************************
+ * segmented_decompressor.h
+ * 		Declaraciones de la clase ppmc::segmented_decompressor
+******************************************************************************/
+#ifndef __PPMC_SEGMENTED_DECOMPRESSOR_H_INCLUDED__
+#define __PPMC_SEGMENTED_DECOMPRESSOR_H_INCLUDED__
+
+#include "../commons/io/char_destination.h"
+#include "../commons/concurrency/thread_pool.h"
+#include "context_container_factory.h"
+#include "segmented_format.h"
+#include <iostream>
+#include <stdint.h>
+
+namespace ppmc {
+
+/**
+ * Descompresor PPMC por segmentos. Lee un archivo con el formato
+ * descripto en segmented_format.h y descomprime los segmentos en
+ * paralelo en un thread_pool, cada uno con un ppmc::decompressor y
+ * un contenedor de contextos propios. Cada segmento se valida
+ * contra el tamaño y el CRC-32 guardados en su frame.
+ */
+class segmented_decompressor {
+private:
+	std::istream &input;
+	context_container_factory &factory;
+	commons::concurrency::thread_pool &pool;
+
+	void decompress_segments(commons::io::char_destination &destination, const segmented::header &h,
+		unsigned int first_segment, uint64_t skip, uint64_t length);
+public:
+	/**
+	 * Crea una nueva instancia de segmented_decompressor que lee
+	 * de input, utilizando contenedores de factory y los threads
+	 * de pool
+	 */
+	segmented_decompressor(std::istream &input, context_container_factory &factory, commons::concurrency::thread_pool &pool);
+
+	/**
+	 * Descomprime los segmentos y emite los chars en orden en
+	 * destination. Si el archivo no es válido o algún segmento
+	 * no coincide con su frame eleva commons::io::ioexception.
+	 */
+	void decompress(commons::io::char_destination &destination);
+
+	/**
+	 * Descomprime sólo los length chars que empiezan en la posición
+	 * start del original, decodificando únicamente los segmentos que
+	 * los contienen. Si el rango se pasa del final, emite hasta el
+	 * final. input DEBE permitir posicionarse, ya que los segmentos
+	 * se buscan con el índice del final del archivo.
+	 */
+	void decompress_range(commons::io::char_destination &destination, uint64_t start, uint64_t length);
+};
+
+};
+
+#endif
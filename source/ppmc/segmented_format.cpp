@@ -0,0 +1,176 @@
+/******************************************************************************
+ * segmented_format.cpp
+ * 		Definiciones de las funciones de ppmc::segmented
+******************************************************************************/
+#include "segmented_format.h"
+#include "../commons/io/ioexception.h"
+#include <cstring>
+
+using namespace ppmc::segmented;
+
+namespace {
+
+const char magic[4] = { 'P', 'P', 'M', 'S' };
+const char index_magic[4] = { 'P', 'P', 'M', 'X' };
+const unsigned char version = 1;
+const int trailer_size = 16;
+const int index_entry_size = 16;
+
+void write_integer(std::ostream &output, uint64_t value, int size) {
+	char bytes[8];
+	for (int i = 0; i < size; i++)
+		bytes[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+	output.write(bytes, size);
+}
+
+uint64_t read_integer(std::istream &input, int size) {
+	unsigned char bytes[8];
+	if (!input.read(reinterpret_cast<char *>(bytes), size))
+		throw commons::io::ioexception("Truncated segmented file");
+
+	uint64_t value = 0;
+	for (int i = size - 1; i >= 0; i--)
+		value = (value << 8) | bytes[i];
+	return value;
+}
+
+void write_uint32(std::ostream &output, unsigned int value) {
+	write_integer(output, value, 4);
+}
+
+unsigned int read_uint32(std::istream &input) {
+	return static_cast<unsigned int>(read_integer(input, 4));
+}
+
+};
+
+header::header()
+: max_contexts(0), segment_size(0) {
+
+}
+
+header::header(unsigned int max_contexts, unsigned int segment_size)
+: max_contexts(max_contexts), segment_size(segment_size) {
+
+}
+
+frame::frame()
+: uncompressed_size(0), compressed_size(0), checksum(0) {
+
+}
+
+frame::frame(unsigned int uncompressed_size, unsigned int compressed_size, unsigned int checksum)
+: uncompressed_size(uncompressed_size), compressed_size(compressed_size), checksum(checksum) {
+
+}
+
+bool frame::is_end() const {
+	return uncompressed_size == 0 && compressed_size == 0;
+}
+
+index_entry::index_entry()
+: uncompressed_offset(0), frame_offset(0) {
+
+}
+
+index_entry::index_entry(uint64_t uncompressed_offset, uint64_t frame_offset)
+: uncompressed_offset(uncompressed_offset), frame_offset(frame_offset) {
+
+}
+
+bool index_entry::operator<(const index_entry &other) const {
+	return uncompressed_offset < other.uncompressed_offset;
+}
+
+bool ppmc::segmented::is_segmented(std::istream &input) {
+	// Alcanza con el primer byte, y así funciona también con
+	// streams en los que no se puede volver atrás; read_header
+	// valida el resto del encabezado
+	return input.peek() == magic[0];
+}
+
+void ppmc::segmented::write_header(std::ostream &output, const header &h) {
+	if (h.max_contexts > max_contexts_limit)
+		throw commons::io::ioexception("Too many contexts for a segmented file");
+
+	output.write(magic, sizeof(magic));
+	output.put(static_cast<char>(version));
+	output.put(static_cast<char>(h.max_contexts));
+	write_uint32(output, h.segment_size);
+}
+
+header ppmc::segmented::read_header(std::istream &input) {
+	char bytes[sizeof(magic) + 2];
+	if (!input.read(bytes, sizeof(bytes)) || std::memcmp(bytes, magic, sizeof(magic)) != 0)
+		throw commons::io::ioexception("Not a segmented file");
+	if (static_cast<unsigned char>(bytes[sizeof(magic)]) != version)
+		throw commons::io::ioexception("Unsupported segmented file version");
+
+	header h;
+	h.max_contexts = static_cast<unsigned char>(bytes[sizeof(magic) + 1]);
+	h.segment_size = read_uint32(input);
+	return h;
+}
+
+void ppmc::segmented::write_frame(std::ostream &output, const frame &f) {
+	write_uint32(output, f.uncompressed_size);
+	write_uint32(output, f.compressed_size);
+	write_uint32(output, f.checksum);
+}
+
+frame ppmc::segmented::read_frame(std::istream &input) {
+	frame f;
+	f.uncompressed_size = read_uint32(input);
+	f.compressed_size = read_uint32(input);
+	f.checksum = read_uint32(input);
+	return f;
+}
+
+void ppmc::segmented::write_index(std::ostream &output, const segment_index &segments, uint64_t index_offset) {
+	for (segment_index::const_iterator it = segments.begin(); it != segments.end(); it++) {
+		write_integer(output, it->uncompressed_offset, 8);
+		write_integer(output, it->frame_offset, 8);
+	}
+
+	write_uint32(output, segments.size());
+	write_integer(output, index_offset, 8);
+	output.write(index_magic, sizeof(index_magic));
+}
+
+segment_index ppmc::segmented::read_index(std::istream &input) {
+	input.seekg(0, std::ios_base::end);
+	std::streamoff length = input.tellg();
+	if (!input || length < static_cast<std::streamoff>(header_size + frame_size + trailer_size))
+		throw commons::io::ioexception("Segmented file without index");
+
+	input.seekg(-trailer_size, std::ios_base::end);
+	unsigned int count = read_uint32(input);
+	uint64_t index_offset = read_integer(input, 8);
+	char bytes[sizeof(index_magic)];
+	if (!input.read(bytes, sizeof(bytes)) || std::memcmp(bytes, index_magic, sizeof(index_magic)) != 0)
+		throw commons::io::ioexception("Segmented file without index");
+
+	// El índice ocupa exactamente lo que hay entre su posición y el
+	// pie; se valida antes de reservar lugar para las entradas, para
+	// que un pie corrupto no pida memoria de más
+	uint64_t index_end = static_cast<uint64_t>(length) - trailer_size;
+	if (index_offset < header_size + frame_size || index_offset > index_end
+		|| index_end - index_offset != static_cast<uint64_t>(count) * index_entry_size)
+		throw commons::io::ioexception("Corrupt segmented file index");
+
+	input.seekg(index_offset);
+	segment_index segments(count);
+	for (unsigned int i = 0; i < count; i++) {
+		segments[i].uncompressed_offset = read_integer(input, 8);
+		segments[i].frame_offset = read_integer(input, 8);
+
+		// decompress_range busca en el índice suponiendo que está
+		// ordenado y que empieza en 0
+		bool ordered = i == 0
+			? segments[i].uncompressed_offset == 0
+			: segments[i].uncompressed_offset > segments[i - 1].uncompressed_offset;
+		if (!ordered || segments[i].frame_offset < header_size || segments[i].frame_offset >= index_offset)
+			throw commons::io::ioexception("Corrupt segmented file index");
+	}
+	return segments;
+}
@@ -0,0 +1,150 @@
+/******************************************************************************
+ * segmented_format.h
+ * 		Declaraciones de las funciones de ppmc::segmented
+******************************************************************************/
+#ifndef __PPMC_SEGMENTED_FORMAT_H_INCLUDED__
+#define __PPMC_SEGMENTED_FORMAT_H_INCLUDED__
+
+#include <iostream>
+#include <vector>
+#include <stdint.h>
+
+namespace ppmc {
+
+/**
+ * Formato de un archivo comprimido por segmentos. El archivo empieza
+ * con un encabezado:
+ *
+ *   "PPMS" | versión (1 byte) | máximo de contextos (1 byte) |
+ *   tamaño de segmento (4 bytes)
+ *
+ * y sigue con un frame por segmento, en orden:
+ *
+ *   tamaño sin comprimir (4 bytes) | tamaño comprimido (4 bytes) |
+ *   CRC-32 de los chars sin comprimir (4 bytes) | datos comprimidos
+ *
+ * terminando con un frame con todos sus campos en 0. Después del
+ * último frame hay un índice con una entrada por segmento:
+ *
+ *   posición sin comprimir (8 bytes) | posición del frame (8 bytes)
+ *
+ * y un pie de largo fijo que permite encontrarlo desde el final:
+ *
+ *   cantidad de entradas (4 bytes) | posición del índice (8 bytes) |
+ *   "PPMX"
+ *
+ * Los enteros se guardan en little endian. Cada segmento se comprime
+ * con un modelo de contextos propio, así que con el índice se puede
+ * descomprimir cualquier rango sin decodificar los anteriores.
+ *
+ * Un archivo comprimido en forma secuencial nunca empieza con 'P'
+ * (el primer byte del compresor aritmético es 0 o 1), por lo que
+ * los dos formatos se distinguen por el encabezado.
+ */
+namespace segmented {
+
+/**
+ * Encabezado de un archivo comprimido por segmentos
+ */
+struct header {
+	unsigned int max_contexts;
+	unsigned int segment_size;
+
+	header();
+	header(unsigned int max_contexts, unsigned int segment_size);
+};
+
+/**
+ * Encabezado del frame de un segmento
+ */
+struct frame {
+	unsigned int uncompressed_size;
+	unsigned int compressed_size;
+	unsigned int checksum;
+
+	frame();
+	frame(unsigned int uncompressed_size, unsigned int compressed_size, unsigned int checksum);
+
+	/**
+	 * Devuelve true si es el frame que marca el fin del archivo
+	 */
+	bool is_end() const;
+};
+
+/**
+ * Entrada del índice de segmentos
+ */
+struct index_entry {
+	uint64_t uncompressed_offset;
+	uint64_t frame_offset;
+
+	index_entry();
+	index_entry(uint64_t uncompressed_offset, uint64_t frame_offset);
+
+	bool operator<(const index_entry &other) const;
+};
+
+typedef std::vector<index_entry> segment_index;
+
+/**
+ * Cantidad de bytes que ocupa el encabezado del archivo
+ */
+const unsigned int header_size = 10;
+
+/**
+ * Cantidad de bytes que ocupa el encabezado de un frame
+ */
+const unsigned int frame_size = 12;
+
+/**
+ * Máximo de contextos que se puede guardar en el byte del encabezado
+ */
+const unsigned int max_contexts_limit = 255;
+
+/**
+ * Devuelve true si el stream empieza con el encabezado de un
+ * archivo comprimido por segmentos. No consume chars del stream,
+ * así que sirve también para la entrada estándar.
+ */
+bool is_segmented(std::istream &input);
+
+/**
+ * Escribe el encabezado del archivo. Si el máximo de contextos no
+ * entra en el encabezado eleva commons::io::ioexception.
+ */
+void write_header(std::ostream &output, const header &h);
+
+/**
+ * Lee el encabezado del archivo. Si no es un encabezado válido
+ * eleva commons::io::ioexception.
+ */
+header read_header(std::istream &input);
+
+/**
+ * Escribe el encabezado de un frame
+ */
+void write_frame(std::ostream &output, const frame &f);
+
+/**
+ * Lee el encabezado de un frame. Si el archivo está truncado eleva
+ * commons::io::ioexception.
+ */
+frame read_frame(std::istream &input);
+
+/**
+ * Escribe el índice de segmentos y el pie del archivo. index_offset
+ * es la posición del stream en la que empieza el índice.
+ */
+void write_index(std::ostream &output, const segment_index &segments, uint64_t index_offset);
+
+/**
+ * Lee el índice de segmentos a partir del pie, al final del stream,
+ * que DEBE permitir posicionarse. Si el pie no es válido eleva
+ * commons::io::ioexception.
+ */
+segment_index read_index(std::istream &input);
+
+};
+};
+
+#endif
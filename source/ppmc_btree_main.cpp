@@ -6,18 +6,102 @@
 #include "arithmetic/symbol_distribution.h"
 #include "bplus/bplus_container.h"
 #include "commons/cmdline/compression_client.h"
+#include "commons/io/directory.h"
+#include "commons/io/ioexception.h"
 #include "config/config.h"
 #include <cstdio>
 #include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+#include <iostream>
+
+namespace {
+
+typedef bplus::bplus_container<std::string, arithmetic::symbol_distribution> context_tree;
+
+/**
+ * Junta en orden los pares clave-valor de un árbol
+ */
+struct element_collector : public container::element_inspector<std::string, arithmetic::symbol_distribution> {
+	std::vector<std::pair<std::string, arithmetic::symbol_distribution> > elements;
+
+	virtual void inspect(const std::string &key, const arithmetic::symbol_distribution &value) {
+		elements.push_back(std::make_pair(key, value));
+	}
+};
+
+/**
+ * Crea cada árbol de contextos sobre un archivo propio, en modo
+ * temporary. El archivo se crea en un directorio temporal
+ * exclusivo, así que varios procesos pueden trabajar a la vez sin
+ * pisarse, y se borra junto con el directorio apenas se abre: el
+ * contenedor lo sigue usando a través de su descriptor, y si el
+ * proceso muere (por ejemplo, con SIGINT o SIGPIPE) no queda nada
+ * en disco.
+ */
+class bplus_container_factory : public ppmc::context_container_factory {
+public:
+	virtual context_container *create_container() {
+		commons::io::directory store(commons::io::directory::create_temporary("ppmct"));
+		std::string filename = store.get_path() + "/contexts.data";
+
+		context_container *container;
+		try {
+			container = new context_tree(filename.c_str(), BPLUS_BLOCK_SIZE, commons::io::temporary);
+		} catch (...) {
+			store.remove();
+			throw;
+		}
+		store.remove();
+		return container;
+	}
+
+	virtual void destroy_container(context_container *container) {
+		delete container;
+	}
+
+	virtual context_container *open_container(const std::string &path, commons::io::open_mode mode) {
+		return new context_tree(path.c_str(), BPLUS_BLOCK_SIZE, mode);
+	}
+
+	/**
+	 * Vuelve a armar el árbol con bulk_load, con los nodos llenos,
+	 * en un archivo nuevo que después reemplaza al original. Los
+	 * elementos se juntan en memoria, así que alcanza para árboles
+	 * del tamaño de un diccionario.
+	 */
+	virtual void compact_container(const std::string &path) {
+		element_collector collector;
+		{
+			context_tree original(path.c_str(), BPLUS_BLOCK_SIZE, commons::io::read_only);
+			original.inspect(collector);
+		}
+
+		std::string compacted_path = path + ".compacted";
+		std::remove(compacted_path.c_str());
+		try {
+			context_tree compacted(compacted_path.c_str(), BPLUS_BLOCK_SIZE);
+			compacted.bulk_load(collector.elements.begin(), collector.elements.end());
+		} catch (...) {
+			std::remove(compacted_path.c_str());
+			throw;
+		}
+
+		if (std::rename(compacted_path.c_str(), path.c_str()) != 0)
+			throw commons::io::ioexception("Could not replace '" + path + "' with its compacted copy");
+	}
+};
+
+};
 
 int main(int argc, char **argv) {
-	container::associative_container<std::string, arithmetic::symbol_distribution> *container
-		= new bplus::bplus_container<std::string, arithmetic::symbol_distribution>("contexts.data", BPLUS_BLOCK_SIZE);
-	{
-		commons::cmdline::compression_client client(container);
-		client.run(argc, argv);
+	try {
+		bplus_container_factory factory;
+		commons::cmdline::compression_client client(&factory);
+		return client.run(argc, argv);
+	} catch (commons::io::ioexception &e) {
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
 	}
-	delete container;
-	std::remove("contexts.data");
-	return EXIT_SUCCESS;
 }
@@ -6,19 +6,73 @@
 #include "arithmetic/symbol_distribution.h"
 #include "hash/hash_container.h"
 #include "commons/cmdline/compression_client.h"
+#include "commons/io/directory.h"
+#include "commons/io/ioexception.h"
 #include "config/config.h"
-#include <cstdio>
 #include <cstdlib>
+#include <memory>
+#include <string>
+#include <iostream>
+
+namespace {
+
+typedef hash::hash_container<std::string, arithmetic::symbol_distribution> context_hash;
+
+/**
+ * Crea cada hash de contextos sobre un par de archivos propio, en
+ * modo temporary. Los archivos se crean en un directorio temporal
+ * exclusivo, así que varios procesos pueden trabajar a la vez sin
+ * pisarse, y se borran junto con el directorio apenas se abren: el
+ * contenedor los sigue usando a través de sus descriptores, y si
+ * el proceso muere (por ejemplo, con SIGINT o SIGPIPE) no queda
+ * nada en disco.
+ */
+class hash_container_factory : public ppmc::context_container_factory {
+public:
+	virtual context_container *create_container() {
+		commons::io::directory store(commons::io::directory::create_temporary("ppmch"));
+		std::string data_filename = store.get_path() + "/contexts.data";
+		std::string index_filename = store.get_path() + "/contexts.index";
+
+		context_container *container;
+		try {
+			container = new context_hash(data_filename.c_str(), index_filename.c_str(), HASH_BLOCK_SIZE, commons::io::temporary);
+		} catch (...) {
+			store.remove();
+			throw;
+		}
+		store.remove();
+		return container;
+	}
+
+	/**
+	 * Cierra el hash antes de destruirlo, para informar si no se
+	 * pudo guardar la tabla de un hash abierto con open_container
+	 */
+	virtual void destroy_container(context_container *container) {
+		std::auto_ptr<context_container> deleter(container);
+		static_cast<context_hash *>(container)->close();
+	}
+
+	/**
+	 * El hash se guarda en los archivos path.data y path.index
+	 */
+	virtual context_container *open_container(const std::string &path, commons::io::open_mode mode) {
+		std::string data_filename = path + ".data";
+		std::string index_filename = path + ".index";
+		return new context_hash(data_filename.c_str(), index_filename.c_str(), HASH_BLOCK_SIZE, mode);
+	}
+};
+
+};
 
 int main(int argc, char **argv) {
-	container::associative_container<std::string, arithmetic::symbol_distribution> *container
-		= new hash::hash_container<std::string, arithmetic::symbol_distribution>("contexts.data", "contexts.index", HASH_BLOCK_SIZE);
-	{
-		commons::cmdline::compression_client client(container);
-		client.run(argc, argv);
+	try {
+		hash_container_factory factory;
+		commons::cmdline::compression_client client(&factory);
+		return client.run(argc, argv);
+	} catch (commons::io::ioexception &e) {
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
 	}
-	delete container;
-	std::remove("contexts.data");
-	std::remove("contexts.index");
-	return EXIT_SUCCESS;
 }
@@ -0,0 +1,15 @@
+/******************************************************************************
+ * main.cpp
+ * 		Punto de entrada al programa cuando se compila el ejecutable que
+ * 		permite interfacear con el compresor PPMC con trie en memoria
+******************************************************************************/
+#include "ppmc/memory_container_factory.h"
+#include "commons/cmdline/compression_client.h"
+#include "config/config.h"
+#include <cstdlib>
+
+int main(int argc, char **argv) {
+	ppmc::memory_container_factory factory(TRIE_MEMORY_LIMIT);
+	commons::cmdline::compression_client client(&factory);
+	return client.run(argc, argv);
+}
@@ -0,0 +1,147 @@
+#include "../../dependencies/tut/tut.hpp"
+#include "../../arithmetic/range_compressor.h"
+#include "../../arithmetic/range_decompressor.h"
+#include "../../commons/io/stream_binary_destination.h"
+#include "../../commons/io/stream_binary_source.h"
+#include <sstream>
+#include <vector>
+
+using namespace arithmetic;
+
+namespace {
+
+struct test_data {
+	std::stringstream stream;
+
+	void compress_adaptive(const std::string &what) {
+		commons::io::stream_binary_destination destination(stream);
+		range_compressor compressor(destination);
+		symbol_distribution distribution;
+		for (std::string::size_type i = 0; i < what.size(); i++) {
+			symbol s = symbol::for_char(what[i]);
+			if (!distribution.has_symbol(s)) {
+				distribution.register_symbol_emision(s);
+			}
+			compressor.compress(s, distribution);
+			distribution.register_symbol_emision(s);
+		}
+		compressor.finish_compression();
+	}
+
+	std::string decompress_adaptive(const std::string &what) {
+		stream.seekg(0);
+		commons::io::stream_binary_source source(stream);
+		range_decompressor decompressor(source);
+		symbol_distribution distribution;
+		std::string result;
+		for (std::string::size_type i = 0; i < what.size(); i++) {
+			// El decompresor conoce los símbolos por adelantado
+			// para poder replicar las distribuciones del compresor
+			symbol expected = symbol::for_char(what[i]);
+			if (!distribution.has_symbol(expected)) {
+				distribution.register_symbol_emision(expected);
+			}
+			symbol s = decompressor.decompress(distribution);
+			result += s.get_char_code();
+			distribution.register_symbol_emision(s);
+		}
+		return result;
+	}
+};
+
+tut::test_group<test_data> test_group("arithmetic::range_compressor class unit tests");
+
+};
+
+namespace tut {
+
+template<>
+template<>
+void test_group<test_data>::object::test<1>() {
+	set_test_name("Test range coder round trip with a fixed distribution");
+
+	symbol_distribution distribution;
+	distribution.register_symbol_emision(symbol::for_char('s'));
+	distribution.register_symbol_emision(symbol::for_char('l'));
+	distribution.register_symbol_emision(symbol::for_char('o'));
+
+	std::vector<symbol> sequence;
+	sequence.push_back(symbol::for_char('s'));
+	sequence.push_back(symbol::for_char('o'));
+	sequence.push_back(symbol::for_char('l'));
+	sequence.push_back(symbol::for_char('o'));
+	sequence.push_back(symbol::ESC);
+
+	{
+		commons::io::stream_binary_destination destination(stream);
+		range_compressor compressor(destination);
+		for (std::size_t i = 0; i < sequence.size(); i++) {
+			compressor.compress(sequence[i], distribution);
+		}
+		compressor.finish_compression();
+	}
+
+	stream.seekg(0);
+	commons::io::stream_binary_source source(stream);
+	range_decompressor decompressor(source);
+	for (std::size_t i = 0; i < sequence.size(); i++) {
+		ensure_equals(decompressor.decompress(distribution).get_sequential_code(), sequence[i].get_sequential_code());
+	}
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<2>() {
+	set_test_name("Test range coder round trip with an adaptive distribution");
+
+	std::string text;
+	for (int i = 0; i < 200; i++) {
+		text += "tapatapitatapon ";
+	}
+
+	compress_adaptive(text);
+
+	// Un texto tan repetitivo tiene que comprimir bien
+	ensure(stream.str().size() < text.size() / 2);
+	ensure_equals(decompress_adaptive(text), text);
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<3>() {
+	set_test_name("Test range coder carry propagation with skewed distributions");
+
+	// Un símbolo muy probable seguido de uno muy improbable fuerza
+	// a que se acumulen bytes pendientes y se propague el acarreo
+	std::string text;
+	for (int i = 0; i < 3000; i++) {
+		text += (i % 97 == 0) ? 'z' : 'a';
+	}
+
+	compress_adaptive(text);
+	ensure_equals(decompress_adaptive(text), text);
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<4>() {
+	set_test_name("Test range coder round trip with long inputs");
+
+	// Sin reescalar, la frecuencia total superaría la que admite
+	// el range coder
+	std::string text;
+	for (int i = 0; i < 100000; i++) {
+		text += static_cast<char>('a' + (i * 7) % (i % 5 == 0 ? 3 : 11));
+	}
+
+	symbol_distribution distribution;
+	for (std::string::size_type i = 0; i < text.size(); i++) {
+		distribution.register_symbol_emision(symbol::for_char(text[i]));
+	}
+	ensure(distribution.get_total_frequency() < ARITHMETIC_RANGE_CODER_MAX_TOTAL);
+
+	compress_adaptive(text);
+	ensure_equals(decompress_adaptive(text), text);
+}
+
+};
@@ -141,9 +141,10 @@ void test_group<test_data>::object::test<5>() {
 	distribution.append_to_exclusion_set(exclusion);
 
 	ensure_equals(exclusion.size(), 3u);
-	ensure(exclusion.end() != exclusion.find(symbol::for_char('v')));
-	ensure(exclusion.end() != exclusion.find(symbol::for_char('o')));
-	ensure(exclusion.end() != exclusion.find(symbol::for_char('y')));
+	ensure(exclusion.contains(symbol::for_char('v')));
+	ensure(exclusion.contains(symbol::for_char('o')));
+	ensure(exclusion.contains(symbol::for_char('y')));
+	ensure(!exclusion.contains(symbol::ESC));
 }
 
 template<>
@@ -162,7 +163,7 @@ void test_group<test_data>::object::test<6>() {
 	exclusion.insert(symbol::for_char('c'));
 	exclusion.insert(symbol::for_char('h'));
 
-	symbol_distribution excluded = distribution.exclude(exclusion);
+	symbol_distribution::excluded_view excluded = distribution.exclude(exclusion);
 
 	ensure_equals(excluded.get_emissions(symbol::for_char('j')), 2u);
 	ensure_equals(excluded.get_emissions(symbol::ESC), 1u);
@@ -173,5 +174,203 @@ void test_group<test_data>::object::test<6>() {
 	ensure_equals(excluded.get_emissions(symbol::for_char('c')), 0u);
 	ensure_equals(excluded.get_emissions(symbol::for_char('h')), 0u);
 }
-};
 
+template<>
+template<>
+void test_group<test_data>::object::test<7>() {
+	set_test_name("Test accumulated frequencies");
+
+	distribution.register_symbol_emision(symbol::for_char('a'));
+	distribution.register_symbol_emision(symbol::for_char('a'));
+	distribution.register_symbol_emision(symbol::for_char('b'));
+
+	ensure_equals(distribution.get_total_frequency(), 4u);
+	ensure_equals(distribution.get_accumulated_frequency(symbol::for_char('a')), 0u);
+	ensure_equals(distribution.get_accumulated_frequency(symbol::for_char('b')), 2u);
+	ensure_equals(distribution.get_accumulated_frequency(symbol::ESC), 3u);
+
+	ensure_equals(distribution.get_symbol_for_frequency(0).get_sequential_code(), symbol::for_char('a').get_sequential_code());
+	ensure_equals(distribution.get_symbol_for_frequency(1).get_sequential_code(), symbol::for_char('a').get_sequential_code());
+	ensure_equals(distribution.get_symbol_for_frequency(2).get_sequential_code(), symbol::for_char('b').get_sequential_code());
+	ensure_equals(distribution.get_symbol_for_frequency(3).get_sequential_code(), symbol::ESC.get_sequential_code());
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<8>() {
+	set_test_name("Test accumulated frequencies over every symbol and after excluding");
+
+	for (unsigned int c = 0; c < 256; c++) {
+		for (unsigned int i = 0; i < c % 5; i++) {
+			distribution.register_symbol_emision(symbol::for_char(c));
+		}
+	}
+	distribution.register_symbol_emision(symbol::SEOF);
+
+	unsigned int accumulated = 0;
+	for (unsigned int code = 0; code < ARITHMETIC_SYMBOL_COUNT; code++) {
+		symbol current(code);
+		ensure_equals(distribution.get_accumulated_frequency(current), accumulated);
+		for (unsigned int i = 0; i < distribution.get_emissions(current); i++) {
+			ensure_equals(distribution.get_symbol_for_frequency(accumulated + i).get_sequential_code(), code);
+		}
+		accumulated += distribution.get_emissions(current);
+	}
+	ensure_equals(distribution.get_total_frequency(), accumulated);
+
+	symbol_distribution::exclusion_set exclusion;
+	exclusion.insert(symbol::for_char(1));
+	exclusion.insert(symbol::for_char(2));
+	symbol_distribution::excluded_view excluded = distribution.exclude(exclusion);
+
+	ensure_equals(excluded.get_total_frequency(), accumulated - 3);
+	ensure_equals(excluded.get_accumulated_frequency(symbol::for_char(3)), 0u);
+	ensure_equals(excluded.get_symbol_for_frequency(0).get_sequential_code(), 3u);
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<9>() {
+	set_test_name("Test excluded view against every symbol");
+
+	for (unsigned int c = 0; c < 256; c++) {
+		for (unsigned int i = 0; i < c % 3; i++) {
+			distribution.register_symbol_emision(symbol::for_char(c));
+		}
+	}
+
+	// Excluyo un símbolo de cada siete, incluyendo algunos sin emisiones
+	symbol_distribution::exclusion_set exclusion;
+	for (unsigned int c = 0; c < 256; c += 7) {
+		exclusion.insert(symbol::for_char(c));
+	}
+
+	symbol_distribution::excluded_view excluded = distribution.exclude(exclusion);
+
+	unsigned int accumulated = 0;
+	for (unsigned int code = 0; code < ARITHMETIC_SYMBOL_COUNT; code++) {
+		symbol current(code);
+		unsigned int expected_emissions = exclusion.contains(current) ? 0u : distribution.get_emissions(current);
+
+		ensure_equals(excluded.get_emissions(current), expected_emissions);
+		ensure_equals(excluded.get_accumulated_frequency(current), accumulated);
+		for (unsigned int i = 0; i < expected_emissions; i++) {
+			ensure_equals(excluded.get_symbol_for_frequency(accumulated + i).get_sequential_code(), code);
+		}
+		accumulated += expected_emissions;
+	}
+	ensure_equals(excluded.get_total_frequency(), accumulated);
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<10>() {
+	set_test_name("Test compact distributions before and after growing past the limit");
+
+	// Cada símbolo nuevo se registra fuera de orden, y después de
+	// agregarlo se compara todo contra la cuenta esperada, tanto en
+	// la representación compacta como después de pasar el límite
+	unsigned int expected[ARITHMETIC_SYMBOL_COUNT] = { 0 };
+	expected[symbol::ESC.get_sequential_code()] = 1;
+	for (unsigned int n = 0; n < ARITHMETIC_SPARSE_DISTRIBUTION_LIMIT + 4; n++) {
+		unsigned int c = (n * 37 + 11) % 256;
+		for (unsigned int i = 0; i <= n % 3; i++) {
+			distribution.register_symbol_emision(symbol::for_char(c));
+			expected[symbol::for_char(c).get_sequential_code()]++;
+		}
+
+		symbol_distribution copy(distribution);
+		symbol_distribution::exclusion_set exclusion;
+		exclusion.insert(symbol::for_char(11));
+		symbol_distribution::excluded_view excluded = copy.exclude(exclusion);
+
+		unsigned int accumulated = 0;
+		unsigned int excluded_accumulated = 0;
+		unsigned int iterated = 0;
+		for (symbol_distribution::iterator it = copy.begin(); it != copy.end(); it++)
+			iterated++;
+
+		unsigned int distinct = 0;
+		for (unsigned int code = 0; code < ARITHMETIC_SYMBOL_COUNT; code++) {
+			symbol current(code);
+			distinct += (expected[code] > 0 ? 1 : 0);
+			ensure_equals(copy.get_emissions(current), expected[code]);
+			ensure_equals(copy.get_accumulated_frequency(current), accumulated);
+			ensure_equals(excluded.get_accumulated_frequency(current), excluded_accumulated);
+			for (unsigned int i = 0; i < expected[code]; i++)
+				ensure_equals(copy.get_symbol_for_frequency(accumulated + i).get_sequential_code(), code);
+
+			accumulated += expected[code];
+			if (!exclusion.contains(current)) {
+				for (unsigned int i = 0; i < expected[code]; i++)
+					ensure_equals(excluded.get_symbol_for_frequency(excluded_accumulated + i).get_sequential_code(), code);
+				excluded_accumulated += expected[code];
+			}
+		}
+		ensure_equals(iterated, distinct);
+		ensure_equals(copy.get_total_frequency(), accumulated);
+		ensure_equals(excluded.get_total_frequency(), excluded_accumulated);
+
+		// Sólo la representación con un contador por símbolo aloca
+		// memoria aparte
+		ensure_equals(copy.heap_size() > 0, distinct > ARITHMETIC_SPARSE_DISTRIBUTION_LIMIT);
+		ensure_equals(heap_size_of(copy), copy.heap_size());
+
+		// La serialización no depende de la representación
+		commons::io::block b(1024);
+		commons::io::serialize(copy, &b, 0);
+		ensure_equals(commons::io::serialization_length(copy), commons::io::serialization_length<symbol_distribution>(b, 0));
+		symbol_distribution deserialized = commons::io::deserialize<symbol_distribution>(b, 0);
+		for (unsigned int code = 0; code < ARITHMETIC_SYMBOL_COUNT; code++)
+			ensure_equals(deserialized.get_emissions(symbol(code)), expected[code]);
+
+		// La asignación sobre una distribución en otra representación
+		// tiene que dejar una copia independiente
+		symbol_distribution assigned;
+		for (unsigned int c = 0; c < 256; c++)
+			assigned.register_symbol_emision(symbol::for_char(c));
+		assigned = copy;
+		copy.register_symbol_emision(symbol::SEOF);
+		ensure_equals(assigned.get_total_frequency(), accumulated);
+		ensure_equals(assigned.get_emissions(symbol::SEOF), 0u);
+	}
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<11>() {
+	set_test_name("Test rescaling frequencies once the total exceeds the limit");
+
+	symbol_distribution dense_distribution;
+	for (unsigned int c = 0; c < 256; c++)
+		dense_distribution.register_symbol_emision(symbol::for_char(c));
+
+	// Sumo emisiones de un solo símbolo hasta pasar el límite
+	unsigned int emitted = 1;
+	while (distribution.get_total_frequency() == emitted) {
+		distribution.register_symbol_emision(symbol::for_char('a'));
+		dense_distribution.register_symbol_emision(symbol::for_char('a'));
+		emitted++;
+	}
+	ensure_equals(emitted, ARITHMETIC_DISTRIBUTION_RESCALE_LIMIT + 1u);
+
+	// Las frecuencias se dividen a la mitad redondeando para arriba,
+	// así que el ESC y los chars con una sola emisión siguen estando
+	unsigned int a_emissions = (ARITHMETIC_DISTRIBUTION_RESCALE_LIMIT + 1) / 2;
+	ensure_equals(distribution.get_emissions(symbol::ESC), 1u);
+	ensure_equals(distribution.get_emissions(symbol::for_char('a')), a_emissions);
+	ensure_equals(distribution.get_total_frequency(), a_emissions + 1);
+
+	ensure(dense_distribution.get_total_frequency() <= ARITHMETIC_DISTRIBUTION_RESCALE_LIMIT);
+	unsigned int accumulated = 0;
+	for (unsigned int code = 0; code < ARITHMETIC_SYMBOL_COUNT; code++) {
+		symbol current(code);
+		ensure(code == symbol::SEOF.get_sequential_code() || dense_distribution.has_symbol(current));
+		ensure_equals(dense_distribution.get_accumulated_frequency(current), accumulated);
+		accumulated += dense_distribution.get_emissions(current);
+	}
+	ensure_equals(dense_distribution.get_total_frequency(), accumulated);
+	ensure_equals(dense_distribution.get_symbol_for_frequency(accumulated - 1).get_sequential_code(), symbol::ESC.get_sequential_code());
+}
+
+};
@@ -1,9 +1,14 @@
 #include "../../dependencies/tut/tut.hpp"
 #include "../../bplus/bplus_container.h"
 #include "../../commons/log/log.h"
+#include "../../commons/io/ioexception.h"
 #include <fstream>
 #include <cstdio>
 #include <utility>
+#include <map>
+#include <cstdlib>
+#include <sstream>
+#include <stdexcept>
 
 using namespace std;
 
@@ -128,6 +133,10 @@ public:
 		return bplus::node_factory::create_subtree_from_block<key_type, value_type>(b);
 	}
 
+	int file_block_count() {
+		return file->get_block_count();
+	}
+
 	~inspection() {
 		delete file;
 	}
@@ -140,4 +149,357 @@ tut::test_group<test_data> test_group("bplus::bplus_container class unit tests")
 
 namespace tut {
 
+template<>
+template<>
+void test_group<test_data>::object::test<1>() {
+	set_test_name("Test upserting elements across node splits");
+
+	require_container_size(256);
+
+	// Todas las claves son nuevas, así que el árbol crece
+	for (int i = 0; i < 60; i++) {
+		container->upsert_element((i * 37) % 60, std::string(10, 'A' + i % 26));
+	}
+
+	// Ahora se modifican las existentes, achicando y agrandando
+	// los elementos, y se agregan algunas nuevas
+	for (int i = 0; i < 80; i += 2) {
+		container->upsert_element(i, std::string(i % 4 == 0 ? 2 : 30, 'a' + i % 26));
+	}
+
+	for (int i = 0; i < 80; i++) {
+		search_results result = container->search_for_element(i);
+		if (i % 2 == 0) {
+			ensure(result.first);
+			ensure_equals(result.second, std::string(i % 4 == 0 ? 2 : 30, 'a' + i % 26));
+		} else if (i < 60) {
+			ensure(result.first);
+			ensure_equals(result.second.size(), 10u);
+		} else {
+			ensure(!result.first);
+		}
+	}
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<2>() {
+	set_test_name("Test updating string keys with underflows in inner nodes");
+
+	typedef bplus::bplus_container<std::string, std::string> string_container_type;
+	std::remove("./btree_container_string_test.data");
+
+	// Claves de largo variable en bloques chicos: al resolver el
+	// underflow de una hoja cambian las claves de los nodos internos,
+	// que también pueden desbordarse
+	std::map<std::string, std::string> expected;
+	{
+		string_container_type strings("./btree_container_string_test.data", 512);
+		srand(23);
+		for (int i = 0; i < 3000; i++) {
+			std::stringstream key;
+			key << std::string(1 + rand() % 8, 'k');
+			key << rand() % 300;
+			bool update = rand() % 4 == 1 && expected.count(key.str());
+			int length = rand() % 2 ? 1 : 1 + rand() % 40;
+			std::string value(length, 'a' + rand() % 26);
+
+			if (update) {
+				strings.update_element(key.str(), value);
+			} else {
+				strings.upsert_element(key.str(), value);
+			}
+			expected[key.str()] = value;
+		}
+
+		for (std::map<std::string, std::string>::iterator it = expected.begin(); it != expected.end(); it++) {
+			search_results result = strings.search_for_element(it->first);
+			ensure(result.first);
+			ensure_equals(result.second, it->second);
+		}
+	}
+	std::remove("./btree_container_string_test.data");
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<3>() {
+	set_test_name("Test opening read only");
+
+	require_container_size(256);
+	for (int i = 0; i < 60; i++)
+		container->add_element(i, std::string(10, 'A' + i % 26));
+	delete container;
+	container = NULL;
+
+	container = new container_type("./btree_container_test.data", block_size, commons::io::read_only);
+	for (int i = 0; i < 60; i++)
+		ensure_equals(container->search_for_element(i).second, std::string(10, 'A' + i % 26));
+
+	try {
+		container->upsert_element(0, "nuevo");
+		fail("A read only container was modified");
+	} catch (commons::io::ioexception &e) {
+
+	}
+	ensure_equals(container->search_for_element(0).second, std::string(10, 'A'));
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<4>() {
+	set_test_name("Test bulk loading sorted elements");
+
+	leaf_contents_type elements;
+	for (int i = 0; i < 500; i++)
+		elements.push_back(std::make_pair(i * 2, std::string(10 + i % 7, 'A' + i % 26)));
+
+	// El mismo árbol agregando los elementos de a uno
+	require_container_size(256);
+	for (leaf_contents_type::iterator it = elements.begin(); it != elements.end(); it++)
+		container->add_element(it->first, it->second);
+	std::auto_ptr<commons::io::recycling_block_file> added_file(close_for_inspection());
+	int added_blocks = added_file->get_block_count();
+	added_file.reset();
+
+	require_container_size(256);
+	container->bulk_load(elements.begin(), elements.end());
+	for (leaf_contents_type::iterator it = elements.begin(); it != elements.end(); it++)
+		ensure_equals(container->search_for_element(it->first).second, it->second);
+	ensure(!container->search_for_element(1).first);
+	ensure(!container->search_for_element(1000).first);
+
+	// Las hojas quedan llenas en lugar de a medio llenar
+	inspection i(close_for_inspection());
+	int loaded_blocks = i.file_block_count();
+	ensure(loaded_blocks * 3 < added_blocks * 2);
+
+	// Las hojas están en orden y encadenadas
+	std::auto_ptr<subtree_type> node(i.get_root_of_container());
+	while (is_inner(node))
+		node.reset(i.load_node_from_container(interpret_as_inner(node)->get_leftmost_pointer()));
+
+	int expected = 0;
+	int previous_pointer = -1;
+	while (true) {
+		for (leaf_node_type::iterator it = interpret_as_leaf(node)->begin(); it != interpret_as_leaf(node)->end(); it++) {
+			ensure_equals((*it).first, elements[expected].first);
+			expected++;
+		}
+
+		int next_pointer = interpret_as_leaf(node)->get_next_leaf_pointer();
+		if (next_pointer < 0)
+			break;
+		if (previous_pointer >= 0)
+			ensure_equals(next_pointer, previous_pointer + 1);
+		previous_pointer = next_pointer;
+		node.reset(i.load_node_from_container(next_pointer));
+	}
+	ensure_equals(expected, 500);
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<5>() {
+	set_test_name("Test modifying a bulk loaded container");
+
+	leaf_contents_type elements;
+	for (int i = 0; i < 300; i += 3)
+		elements.push_back(std::make_pair(i, std::string(12, 'a' + i % 26)));
+
+	require_container_size(256);
+	container->bulk_load(elements.begin(), elements.end(), 70);
+
+	// Se agregan elementos entre los cargados, y se borran
+	// y modifican algunos de los cargados
+	for (int i = 1; i < 300; i += 3)
+		container->add_element(i, std::string(20, 'x'));
+	for (int i = 0; i < 300; i += 6)
+		container->delete_element(i);
+	for (int i = 3; i < 300; i += 6)
+		container->update_element(i, "modificado");
+
+	for (int i = 0; i < 300; i++) {
+		search_results result = container->search_for_element(i);
+		if (i % 3 == 1)
+			ensure_equals(result.second, std::string(20, 'x'));
+		else if (i % 6 == 0)
+			ensure(!result.first);
+		else if (i % 6 == 3)
+			ensure_equals(result.second, "modificado");
+		else
+			ensure(!result.first);
+	}
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<6>() {
+	set_test_name("Test bulk loading invalid input");
+
+	leaf_contents_type elements;
+	elements.push_back(std::make_pair(1, std::string("a")));
+	elements.push_back(std::make_pair(3, std::string("b")));
+	elements.push_back(std::make_pair(2, std::string("c")));
+
+	try {
+		container->bulk_load(elements.begin(), elements.end());
+		fail("Unsorted elements were bulk loaded");
+	} catch (std::invalid_argument &e) {
+
+	}
+
+	elements[2].first = 3;
+	require_container_size(4096);
+	try {
+		container->bulk_load(elements.begin(), elements.end());
+		fail("Duplicated elements were bulk loaded");
+	} catch (container_type::duplicate_exception &e) {
+
+	}
+
+	// Pocos elementos quedan en la raiz
+	require_container_size(4096);
+	container->bulk_load(elements.begin(), elements.begin() + 2);
+	ensure_equals(container->search_for_element(3).second, "b");
+
+	try {
+		container->bulk_load(elements.begin(), elements.begin() + 2);
+		fail("A non empty container was bulk loaded");
+	} catch (std::logic_error &e) {
+
+	}
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<7>() {
+	set_test_name("Test bulk loading elements too large for a block");
+
+	leaf_contents_type elements;
+	elements.push_back(std::make_pair(1, std::string("a")));
+	elements.push_back(std::make_pair(2, std::string(300, 'b')));
+
+	require_container_size(256);
+	try {
+		container->bulk_load(elements.begin(), elements.end());
+		fail("An element larger than a leaf was bulk loaded");
+	} catch (std::length_error &e) {
+
+	}
+
+	// El contenedor sigue vacío y se puede volver a cargar
+	ensure(!container->search_for_element(1).first);
+	elements[1].second = "b";
+	container->bulk_load(elements.begin(), elements.end());
+	ensure_equals(container->search_for_element(2).second, "b");
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<8>() {
+	set_test_name("Test bulk loaded inner nodes have two children");
+
+	typedef bplus::bplus_container<std::string, std::string> string_container_type;
+	typedef std::vector<std::pair<std::string, std::string> > string_contents_type;
+	std::remove("./btree_container_string_test.data");
+
+	// Claves largas en bloques chicos: pocas claves por nodo interno,
+	// así que seguido al último nodo de un nivel le queda un único hijo
+	for (int count = 2; count < 120; count++) {
+		string_contents_type elements;
+		for (int i = 0; i < count; i++) {
+			std::stringstream key;
+			key << 1000 + i << std::string(30 + i % 5 * 10, 'k');
+			elements.push_back(std::make_pair(key.str(), std::string(20, 'a' + i % 26)));
+		}
+
+		{
+			string_container_type strings("./btree_container_string_test.data", 256);
+			strings.bulk_load(elements.begin(), elements.end());
+			for (string_contents_type::iterator it = elements.begin(); it != elements.end(); it++)
+				ensure_equals(strings.search_for_element(it->first).second, it->second);
+		}
+
+		commons::io::recycling_block_file file("./btree_container_string_test.data", 256);
+		for (int i = 0; i < file.get_block_count(); i++) {
+			std::auto_ptr<bplus::subtree<std::string, std::string> > node(
+				bplus::node_factory::create_subtree_from_block<std::string, std::string>(file.read_block(i)));
+			bplus::inner_node<std::string, std::string> *inner = dynamic_cast<bplus::inner_node<std::string, std::string> *>(&*node);
+			if (inner != NULL)
+				ensure(inner->get_keys().size() >= 1);
+		}
+		std::remove("./btree_container_string_test.data");
+	}
+
+	// Si en un nodo interno no entran dos claves no hay forma de
+	// repartir cinco hojas
+	string_contents_type huge;
+	for (int i = 0; i < 5; i++)
+		huge.push_back(std::make_pair(std::string(120, 'a' + i), std::string("v")));
+	{
+		string_container_type strings("./btree_container_string_test.data", 256);
+		try {
+			strings.bulk_load(huge.begin(), huge.end());
+			fail("Inner nodes with a single child were bulk loaded");
+		} catch (std::length_error &e) {
+
+		}
+	}
+	std::remove("./btree_container_string_test.data");
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<9>() {
+	set_test_name("Test temporary containers");
+
+	// El archivo se puede borrar apenas se abre
+	container_type *temporary = new container_type("./btree_container_temporary_test.data", 512, commons::io::temporary);
+	std::remove("./btree_container_temporary_test.data");
+
+	for (int i = 0; i < 500; i++)
+		temporary->add_element(i, std::string(20, 'a' + i % 26));
+	for (int i = 0; i < 500; i++)
+		ensure_equals(temporary->search_for_element(i).second, std::string(20, 'a' + i % 26));
+
+	delete temporary;
+	ensure(!std::ifstream("./btree_container_temporary_test.data").is_open());
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<10>() {
+	set_test_name("Test a failed bulk load releases its blocks");
+
+	leaf_contents_type elements;
+	for (int i = 0; i < 300; i++)
+		elements.push_back(std::make_pair(i, std::string(20, 'a' + i % 26)));
+
+	// Lo que ocupa la carga en un archivo nuevo
+	require_container_size(256);
+	container->bulk_load(elements.begin(), elements.end());
+	std::auto_ptr<commons::io::recycling_block_file> loaded(close_for_inspection());
+	int loaded_blocks = loaded->get_block_count();
+	loaded.reset();
+
+	// Una carga que falla al final ya reservó todas las hojas, que
+	// se liberan y se reutilizan en la carga siguiente
+	require_container_size(256);
+	elements.push_back(std::make_pair(0, std::string("desordenado")));
+	try {
+		container->bulk_load(elements.begin(), elements.end());
+		fail("Unsorted elements were bulk loaded");
+	} catch (std::invalid_argument &e) {
+
+	}
+	elements.pop_back();
+	container->bulk_load(elements.begin(), elements.end());
+	for (int i = 0; i < 300; i++)
+		ensure_equals(container->search_for_element(i).second, std::string(20, 'a' + i % 26));
+
+	std::auto_ptr<commons::io::recycling_block_file> reloaded(close_for_inspection());
+	ensure_equals(reloaded->get_block_count(), loaded_blocks);
+}
+
 };
@@ -360,4 +360,41 @@ void test_group<test_data>::object::test<12>() {
 	ensure_node_has(n_right,container_right);
 }
 
+template<>
+template<>
+void test_group<test_data>::object::test<13>() {
+	set_test_name("Test split method with variable length keys");
+
+	typedef bplus::inner_node<std::string, value_type> string_node_type;
+	commons::io::block string_block(block_size);
+	string_node_type string_node(string_block);
+	string_node.clear();
+	string_node.set_leftmost_pointer(1);
+
+	// Las claves ocupan más que un int, así que los punteros
+	// no quedan en una posición fija respecto de la clave
+	std::vector<std::string> keys;
+	for (int i = 0; i < 6; i++) {
+		keys.push_back(std::string(i + 5, 'a' + i));
+		string_node.insert_key_in_order(keys[i], i + 10);
+	}
+
+	string_node_type::split_result result = string_node.split(0, 0, block_size);
+	std::auto_ptr<string_node_type> left((string_node_type *)result.left_node);
+	std::auto_ptr<string_node_type> right((string_node_type *)result.right_node);
+
+	ensure_equals(left->get_leftmost_pointer(), 1);
+	std::vector<std::string> left_keys = left->get_keys();
+	for (unsigned int i = 0; i < left_keys.size(); i++)
+		ensure_equals(left->get_right_pointer_of(left_keys[i]), (int)i + 10);
+
+	int promoted = left_keys.size();
+	ensure_equals(result.middle_key, keys[promoted]);
+	ensure_equals(right->get_leftmost_pointer(), promoted + 10);
+
+	std::vector<std::string> right_keys = right->get_keys();
+	for (unsigned int i = 0; i < right_keys.size(); i++)
+		ensure_equals(right->get_right_pointer_of(right_keys[i]), promoted + (int)i + 11);
+}
+
 };
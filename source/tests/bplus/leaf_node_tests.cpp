@@ -466,4 +466,21 @@ void test_group<test_data>::object::test<24>() {
 	ensure_equals(result.middle_key, 3);
 }
 
+template<>
+template<>
+void test_group<test_data>::object::test<25>() {
+	set_test_name("Test upserting new and existing elements");
+
+	node.upsert_element(300, "CCC");
+	node.upsert_element(100, "AAA");
+	node.upsert_element(300, "C");
+	node.upsert_element(200, "BBBBBB");
+
+	element_container expected;
+	expected.push_back(pair_type(100, "AAA"));
+	expected.push_back(pair_type(200, "BBBBBB"));
+	expected.push_back(pair_type(300, "C"));
+	ensure_node_has(node, expected);
+}
+
 };
@@ -0,0 +1,77 @@
+#include "../../../dependencies/tut/tut.hpp"
+#include "../../../commons/concurrency/thread_pool.h"
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+/**
+ * Tarea que suma los números de 1 a limit, o falla si limit es 0
+ */
+struct sum_task : public commons::concurrency::task {
+	unsigned int limit;
+	unsigned long result;
+
+	sum_task(unsigned int limit) : limit(limit), result(0) {}
+
+	virtual void run() {
+		if (limit == 0)
+			throw std::runtime_error("empty sum");
+		for (unsigned int i = 1; i <= limit; i++)
+			result += i;
+	}
+};
+
+struct test_data {
+	commons::concurrency::thread_pool pool;
+
+	test_data() : pool(3) {}
+};
+
+tut::test_group<test_data> test_group("commons::concurrency::thread_pool class unit tests");
+
+};
+
+namespace tut {
+
+template<>
+template<>
+void test_group<test_data>::object::test<1>() {
+	set_test_name("Test running more tasks than threads");
+
+	ensure_equals(pool.get_thread_count(), 3u);
+
+	std::vector<sum_task *> tasks;
+	for (unsigned int i = 1; i <= 20; i++) {
+		tasks.push_back(new sum_task(i * 1000));
+		pool.submit(tasks.back());
+	}
+
+	for (unsigned int i = 0; i < tasks.size(); i++) {
+		unsigned long limit = (i + 1) * 1000;
+		pool.wait(tasks[i]);
+		ensure(!tasks[i]->has_failed());
+		ensure_equals(tasks[i]->result, limit * (limit + 1) / 2);
+		delete tasks[i];
+	}
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<2>() {
+	set_test_name("Test failing tasks keep their error");
+
+	sum_task failing(0);
+	sum_task working(10);
+	pool.submit(&failing);
+	pool.submit(&working);
+
+	pool.wait(&failing);
+	pool.wait(&working);
+	ensure(failing.has_failed());
+	ensure_equals(failing.get_error(), "empty sum");
+	ensure(!working.has_failed());
+	ensure_equals(working.result, 55ul);
+}
+
+};
@@ -0,0 +1,188 @@
+#include "../../../dependencies/tut/tut.hpp"
+#include "../../../commons/io/block_cache.h"
+#include "../../../commons/io/ioexception.h"
+#include <vector>
+
+namespace {
+
+/**
+ * Almacenamiento en memoria que cuenta los accesos, y que puede
+ * fallar al leer una posición
+ */
+struct counting_storage : public commons::io::block_cache::storage {
+	std::vector<commons::io::block> blocks;
+	int loads;
+	int stores;
+	int failing_position;
+
+	counting_storage() : loads(0), stores(0), failing_position(-1) {
+		for (int i = 0; i < 8; i++) {
+			blocks.push_back(commons::io::block(16));
+			blocks.back()[0] = i;
+		}
+	}
+
+	virtual void load_block(int position, commons::io::block *b) {
+		loads++;
+		if (position == failing_position)
+			throw commons::io::ioexception("Could not read a block");
+		blocks[position].copy_to_block(*b);
+	}
+
+	virtual void store_block(int position, const commons::io::block &b) {
+		stores++;
+		b.copy_to_block(blocks[position]);
+	}
+};
+
+struct test_data {
+	counting_storage storage;
+	commons::io::block b;
+
+	test_data() : b(16) {
+
+	}
+};
+
+tut::test_group<test_data> test_group("commons::io::block_cache class unit tests");
+
+};
+
+namespace tut {
+
+template<>
+template<>
+void test_group<test_data>::object::test<1>() {
+	set_test_name("Test hits and misses");
+
+	commons::io::block_cache cache(16, 2, storage);
+
+	cache.read_block_into(3, &b);
+	ensure_equals(b[0], 3);
+	cache.read_block_into(3, &b);
+	ensure_equals(b[0], 3);
+	cache.read_block_into(5, &b);
+	ensure_equals(b[0], 5);
+
+	ensure_equals(cache.get_hits(), 1u);
+	ensure_equals(cache.get_misses(), 2u);
+	ensure_equals(storage.loads, 2);
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<2>() {
+	set_test_name("Test writes are deferred until flush");
+
+	commons::io::block_cache cache(16, 4, storage);
+
+	b[0] = 42;
+	cache.write_block(1, b);
+	b[0] = 43;
+	cache.write_block(1, b);
+	ensure_equals(storage.stores, 0);
+
+	cache.read_block_into(1, &b);
+	ensure_equals(b[0], 43);
+	ensure_equals(storage.loads, 0);
+
+	cache.flush();
+	ensure_equals(storage.stores, 1);
+	ensure_equals(storage.blocks[1][0], 43);
+
+	// Una vez escrito el bloque deja de estar modificado
+	cache.flush();
+	ensure_equals(storage.stores, 1);
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<3>() {
+	set_test_name("Test dirty blocks are written back on eviction");
+
+	commons::io::block_cache cache(16, 2, storage);
+
+	b[0] = 50;
+	cache.write_block(0, b);
+	cache.read_block_into(1, &b);
+	cache.read_block_into(2, &b);
+	cache.read_block_into(3, &b);
+
+	ensure_equals(storage.stores, 1);
+	ensure_equals(storage.blocks[0][0], 50);
+
+	cache.read_block_into(0, &b);
+	ensure_equals(b[0], 50);
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<4>() {
+	set_test_name("Test referenced blocks get a second chance");
+
+	commons::io::block_cache cache(16, 2, storage);
+
+	cache.read_block_into(0, &b);
+	cache.read_block_into(1, &b);
+	// Desaloja al 0, la aguja queda apuntando al 1
+	cache.read_block_into(2, &b);
+	// El 2 fue referenciado y el 1 no, así que sale el 1
+	cache.read_block_into(2, &b);
+	cache.read_block_into(3, &b);
+	cache.read_block_into(2, &b);
+
+	ensure_equals(cache.get_hits(), 2u);
+	ensure_equals(cache.get_misses(), 4u);
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<5>() {
+	set_test_name("Test cache without capacity goes straight to storage");
+
+	commons::io::block_cache cache(16, 0, storage);
+
+	b[0] = 60;
+	cache.write_block(6, b);
+	ensure_equals(storage.stores, 1);
+
+	cache.read_block_into(6, &b);
+	cache.read_block_into(6, &b);
+	ensure_equals(storage.loads, 2);
+	ensure_equals(cache.get_hits(), 0u);
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<6>() {
+	set_test_name("Test a failed load does not leave a cached block");
+
+	commons::io::block_cache cache(16, 2, storage);
+	cache.read_block_into(0, &b);
+	cache.read_block_into(1, &b);
+
+	// La lectura que falla desaloja un bloque, pero no deja el
+	// frame registrado con sus datos viejos
+	storage.failing_position = 3;
+	try {
+		cache.read_block_into(3, &b);
+		fail("The failed load was not reported");
+	} catch (commons::io::ioexception &e) {
+
+	}
+
+	storage.failing_position = -1;
+	cache.read_block_into(3, &b);
+	ensure_equals(b[0], 3);
+	ensure_equals(storage.loads, 4);
+	ensure_equals(cache.get_hits(), 0u);
+
+	// Y la cache sigue funcionando con sus dos frames
+	cache.read_block_into(3, &b);
+	ensure_equals(cache.get_hits(), 1u);
+	cache.read_block_into(5, &b);
+	cache.read_block_into(6, &b);
+	ensure_equals(b[0], 6);
+}
+
+};
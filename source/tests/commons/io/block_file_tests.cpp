@@ -1,5 +1,6 @@
 #include "../../../dependencies/tut/tut.hpp"
 #include "../../../commons/io/block_file.h"
+#include "../../../commons/io/ioexception.h"
 #include <cstdio>
 
 namespace {
@@ -117,5 +118,74 @@ void test_group<test_data>::object::test<5>() {
 		ensure_equals(written_block[i], b[i]);
 }
 
-};
+template<>
+template<>
+void test_group<test_data>::object::test<6>() {
+	set_test_name("Test appended blocks survive eviction from a small cache");
+
+	file.close();
+	std::remove("test_block_file");
+
+	{
+		// Cache de dos bloques: los bloques agregados se van
+		// desalojando y escribiendo mientras se agregan otros
+		commons::io::block_file small_file("test_block_file", 512, 1024);
+		for (int i = 0; i < 10; i++) {
+			commons::io::block b(small_file.get_block_size());
+			b[0] = i + 1;
+			small_file.append_block(b);
+		}
+		ensure_equals(small_file.get_block_count(), 10);
+
+		// El último bloque agregado sigue en memoria
+		commons::io::block b = small_file.read_block(9);
+		ensure_equals(b[0], 10);
+		ensure_equals(small_file.get_cache_hits(), 1u);
+		ensure_equals(small_file.get_cache_misses(), 0u);
+	}
+
+	commons::io::block_file other_file("test_block_file", 512);
+	ensure_equals(other_file.get_block_count(), 10);
+	for (int i = 0; i < 10; i++) {
+		ensure_equals(other_file.read_block(i)[0], i + 1);
+	}
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<7>() {
+	set_test_name("Test opening read only");
+
+	commons::io::block b(file.get_block_size());
+	b[10] = 'x';
+	file.write_block(0, b);
+	file.close();
+
+	commons::io::block_file read_only_file("test_block_file", 512, commons::io::read_only);
+	ensure(!read_only_file.is_just_created());
+	ensure_equals(read_only_file.get_block_count(), 1);
+	ensure_equals(read_only_file.read_block(0)[10], 'x');
+
+	try {
+		read_only_file.write_block(0, b);
+		fail("A read only file was modified");
+	} catch (commons::io::ioexception &e) {
+
+	}
+
+	try {
+		read_only_file.append_block(b);
+		fail("A block was appended to a read only file");
+	} catch (commons::io::ioexception &e) {
 
+	}
+
+	try {
+		commons::io::block_file missing_file("test_missing_block_file", 512, commons::io::read_only);
+		fail("A missing read only file was created");
+	} catch (commons::io::ioexception &e) {
+
+	}
+}
+
+};
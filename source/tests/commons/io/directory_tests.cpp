@@ -3,6 +3,7 @@
 #include "../../../commons/io/ioexception.h"
 
 #include <cstdio>
+#include <fstream>
 
 struct test_data {
 	commons::io::directory dir;
@@ -77,4 +78,44 @@ void test_group<test_data>::object::test<1>() {
 	ensure_equals(starting_with_c_end_with_dat[0], dir.get_path() + "/c_first_file1.dat");
 }
 
+template<>
+template<>
+void test_group<test_data>::object::test<2>() {
+	set_test_name("Test opening missing and existing directories");
+
+	// El directorio no existe, así que se crea
+	std::remove("./directory_test_reopen/file");
+	std::remove("./directory_test_reopen");
+	commons::io::directory created("./directory_test_reopen");
+
+	std::ofstream f((created.get_path() + "/file").c_str());
+	f.close();
+
+	// Abrir un directorio existente no lo modifica
+	commons::io::directory reopened("./directory_test_reopen");
+	ensure_equals(reopened.get_list_filenames().size(), 1u);
+
+	reopened.remove();
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<3>() {
+	set_test_name("Test creating temporary directories");
+
+	std::string first_path = commons::io::directory::create_temporary("directory_test");
+	std::string second_path = commons::io::directory::create_temporary("directory_test");
+	ensure(first_path != second_path);
+
+	commons::io::directory first(first_path);
+	commons::io::directory second(second_path);
+	std::ofstream file((first.get_path() + "/file").c_str());
+	file.close();
+	ensure_equals(first.get_list_filenames().size(), 1u);
+	ensure_equals(second.get_list_filenames().size(), 0u);
+
+	first.remove();
+	second.remove();
+}
+
 };
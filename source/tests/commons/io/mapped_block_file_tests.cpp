@@ -0,0 +1,155 @@
+#include "../../../dependencies/tut/tut.hpp"
+#include "../../../commons/io/mapped_block_file.h"
+#include "../../../commons/io/ioexception.h"
+#include "../../../commons/utils/stream_utils.h"
+#include <cstdio>
+
+namespace {
+
+struct free_block_initializer : public commons::io::block_file::initializer {
+	virtual void initialize(commons::io::block_file *file) const {
+		file->append_block(commons::io::block(512));
+	}
+};
+
+struct test_data {
+	commons::io::mapped_block_file file;
+
+	test_data() : file("test_mapped_block_file", 512, free_block_initializer()) {
+
+	}
+
+	~test_data() {
+		file.close();
+		std::remove("test_mapped_block_file");
+	}
+};
+
+tut::test_group<test_data> test_group("commons::io::mapped_block_file class unit tests");
+
+};
+
+namespace tut {
+
+template<>
+template<>
+void test_group<test_data>::object::test<1>() {
+	set_test_name("Test reading and writing blocks");
+
+	commons::io::block b(file.get_block_size());
+	for (int i = 0; i < b.get_size(); i++)
+		b[i] = (i % 100) + 1;
+
+	file.write_block(0, b);
+
+	commons::io::block written_block = file.read_block(0);
+
+	for (int i = 0; i < b.get_size(); i++) {
+		ensure_equals(written_block[i], b[i]);
+	}
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<2>() {
+	set_test_name("Test the file grows by whole extents and is cut on close");
+
+	// El bloque del initializer ya agrandó el archivo a un extent
+	ensure_equals(commons::utils::streams::file_size("test_mapped_block_file"), BLOCK_FILE_MAPPED_EXTENT_SIZE);
+
+	commons::io::block b(file.get_block_size());
+	b[10] = 'x';
+	file.append_block(b);
+	ensure_equals(file.read_block(1)[10], 'x');
+	ensure_equals(commons::utils::streams::file_size("test_mapped_block_file"), BLOCK_FILE_MAPPED_EXTENT_SIZE);
+
+	file.close();
+	ensure_equals(commons::utils::streams::file_size("test_mapped_block_file"), 2 * 512);
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<3>() {
+	set_test_name("Test growing the mapping and reopening");
+
+	file.close();
+	std::remove("test_mapped_block_file");
+
+	int block_size = 1024 * 1024;
+	int block_count = BLOCK_FILE_MAPPED_EXTENT_SIZE / block_size + 2;
+	{
+		commons::io::mapped_block_file big_file("test_mapped_block_file", block_size);
+		ensure(big_file.is_just_created());
+		for (int i = 0; i < block_count; i++) {
+			commons::io::block b(block_size);
+			b[0] = i + 1;
+			b[block_size - 1] = i + 2;
+			big_file.append_block(b);
+		}
+	}
+
+	// El archivo mide lo que ocupan los bloques, no lo que ocupa el mapeo
+	ensure_equals(commons::utils::streams::file_size("test_mapped_block_file"), block_count * block_size);
+
+	commons::io::mapped_block_file other_file("test_mapped_block_file", block_size);
+	ensure(!other_file.is_just_created());
+	ensure_equals(other_file.get_block_count(), block_count);
+	for (int i = 0; i < block_count; i++) {
+		commons::io::block b = other_file.read_block(i);
+		ensure_equals(b[0], i + 1);
+		ensure_equals(b[block_size - 1], i + 2);
+	}
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<4>() {
+	set_test_name("Test opening read only");
+
+	commons::io::block b(file.get_block_size());
+	b[10] = 'x';
+	file.write_block(0, b);
+	file.close();
+
+	commons::io::mapped_block_file read_only_file("test_mapped_block_file", 512, commons::io::read_only);
+	ensure(!read_only_file.is_just_created());
+	ensure_equals(read_only_file.get_block_count(), 1);
+	ensure_equals(read_only_file.read_block(0)[10], 'x');
+
+	try {
+		read_only_file.write_block(0, b);
+		fail("A read only file was modified");
+	} catch (commons::io::ioexception &e) {
+
+	}
+
+	try {
+		commons::io::mapped_block_file missing_file("test_missing_mapped_block_file", 512, commons::io::read_only);
+		fail("A missing read only file was created");
+	} catch (commons::io::ioexception &e) {
+
+	}
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<5>() {
+	set_test_name("Test reopening without closing");
+
+	for (int i = 0; i < 3; i++) {
+		commons::io::block b(file.get_block_size());
+		b[0] = 'a' + i;
+		file.append_block(b);
+	}
+
+	// Sin cerrar el archivo (como tras una caída del proceso) los
+	// bloques agregados están, seguidos de bloques en cero hasta
+	// completar el extent
+	commons::io::mapped_block_file other_file("test_mapped_block_file", 512, commons::io::read_only);
+	ensure_equals(other_file.get_block_count(), BLOCK_FILE_MAPPED_EXTENT_SIZE / 512);
+	for (int i = 0; i < 3; i++)
+		ensure_equals(other_file.read_block(i + 1)[0], 'a' + i);
+	ensure_equals(other_file.read_block(4)[0], 0);
+}
+
+};
@@ -0,0 +1,108 @@
+#include "../../../dependencies/tut/tut.hpp"
+#include "../../../commons/io/mapped_char_source.h"
+#include "../../../commons/io/ioexception.h"
+
+#include <fstream>
+#include <string>
+#include <cstdio>
+#include <sstream>
+#include <unistd.h>
+
+namespace {
+
+struct test_data {
+	test_data() {
+		std::ofstream file("mapped_char_source_test", std::ios_base::out | std::ios_base::binary);
+		file << "PRUEBA DE read";
+	}
+
+	~test_data() {
+		std::remove("mapped_char_source_test");
+		std::remove("mapped_char_source_empty_test");
+	}
+};
+
+tut::test_group<test_data> test_group("commons::io::mapped_char_source class unit tests");
+
+};
+
+namespace tut {
+
+template<>
+template<>
+void test_group<test_data>::object::test<1>() {
+	set_test_name("Test getting chars and spans from a mapped file");
+
+	commons::io::mapped_char_source source("mapped_char_source_test");
+
+	std::pair<bool, unsigned char> first = source.get_next_char();
+	ensure(first.first);
+	ensure_equals(first.second, 'P');
+
+	unsigned char buffer[8];
+	ensure_equals(source.read(buffer, 6), 6u);
+	ensure_equals(std::string(buffer, buffer + 6), "RUEBA ");
+
+	ensure_equals(source.read(buffer, sizeof(buffer)), 7u);
+	ensure_equals(std::string(buffer, buffer + 7), "DE read");
+
+	ensure_equals(source.read(buffer, sizeof(buffer)), 0u);
+	ensure(!source.get_next_char().first);
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<2>() {
+	set_test_name("Test empty and missing files");
+
+	{
+		std::ofstream file("mapped_char_source_empty_test");
+	}
+	commons::io::mapped_char_source empty("mapped_char_source_empty_test");
+	unsigned char buffer[8];
+	ensure_equals(empty.read(buffer, sizeof(buffer)), 0u);
+	ensure(!empty.get_next_char().first);
+
+	try {
+		commons::io::mapped_char_source missing("mapped_char_source_missing_test");
+		fail("ioexception not thrown");
+	} catch (commons::io::ioexception &e) {
+
+	}
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<3>() {
+	set_test_name("Test reading from a pipe");
+
+	// Un pipe dice medir 0 bytes, pero no está vacío
+	int descriptors[2];
+	ensure_equals(pipe(descriptors), 0);
+	std::string chars;
+	for (int i = 0; i < 1000; i++)
+		chars += "pipe ";
+	ensure_equals(write(descriptors[1], chars.data(), chars.size()), static_cast<ssize_t>(chars.size()));
+	close(descriptors[1]);
+
+	std::stringstream filename;
+	filename << "/dev/fd/" << descriptors[0];
+	std::string read_chars;
+	{
+		commons::io::mapped_char_source source(filename.str().c_str());
+		std::pair<bool, unsigned char> first = source.get_next_char();
+		ensure(first.first);
+		read_chars += first.second;
+
+		unsigned char buffer[300];
+		std::size_t count;
+		while ((count = source.read(buffer, sizeof(buffer))) > 0)
+			read_chars.append(buffer, buffer + count);
+		ensure(!source.get_next_char().first);
+	}
+	close(descriptors[0]);
+
+	ensure_equals(read_chars, chars);
+}
+
+};
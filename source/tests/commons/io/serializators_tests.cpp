@@ -63,5 +63,29 @@ void test_group<test_data>::object::test<1>() {
 	ensure_equals(serialization_length<char>(b, position), serialization_length('u'));
 }
 
+template<>
+template<>
+void test_group<test_data>::object::test<2>() {
+	set_test_name("Test comparing instances against serialized instances");
+
+	serialize(150, &b, 0);
+	ensure(compare_serialized(100, b, 0) < 0);
+	ensure(compare_serialized(150, b, 0) == 0);
+	ensure(compare_serialized(200, b, 0) > 0);
+
+	serialize(string("casa"), &b, 0);
+	ensure(compare_serialized(string("casa"), b, 0) == 0);
+	ensure(compare_serialized(string("cas"), b, 0) < 0);
+	ensure(compare_serialized(string("casas"), b, 0) > 0);
+	ensure(compare_serialized(string("cama"), b, 0) < 0);
+	ensure(compare_serialized(string("cosa"), b, 0) > 0);
+	ensure(compare_serialized(string(""), b, 0) < 0);
+
+	// Los chars se comparan igual que en std::string
+	serialize(string("a\xe9"), &b, 0);
+	ensure(compare_serialized(string("ab"), b, 0) < 0);
+	ensure(compare_serialized(string("a\xff"), b, 0) > 0);
+}
+
 };
 
@@ -102,6 +102,46 @@ void test_group<test_data>::object::test<2>() {
 	}
 }
 
+template<>
+template<>
+void test_group<test_data>::object::test<3>() {
+	set_test_name("Test emitting and reading several bits at once");
+
+	std::stringstream stream;
+
+	// Suficientes grupos para pasar varias veces por el buffer
+	const int groups = 20000;
+	{
+		commons::io::stream_binary_destination destination(stream);
+		for (int i = 0; i < groups; i++) {
+			destination.emit_bits(i, 1 + i % 64);
+			destination.emit_bit(i % 2);
+			destination.emit_bits(0xFFFFFFFFFFFFFFFFull, 64);
+		}
+	}
+
+	stream.seekg(0);
 
+	{
+		commons::io::stream_binary_source source(stream);
+		for (int i = 0; i < groups; i++) {
+			int count = 1 + i % 64;
+			uint64_t expected = count == 64 ? i : i & ((static_cast<uint64_t>(1) << count) - 1);
+			std::pair<bool, uint64_t> result = source.read_bits(count);
+			ensure(result.first);
+			ensure_equals(result.second, expected);
+			ensure_result(source.get_next_bit(), i % 2);
+			result = source.read_bits(64);
+			ensure(result.first);
+			ensure_equals(result.second, 0xFFFFFFFFFFFFFFFFull);
+		}
+
+		// El último byte se completó con ceros
+		std::pair<bool, uint64_t> result = source.read_bits(16);
+		ensure(!result.first);
+		ensure_equals(result.second >> 8, 0u);
+		ensure_result_end(source.get_next_bit());
+	}
+}
 
 };
@@ -1,5 +1,6 @@
 #include "../../../dependencies/tut/tut.hpp"
 #include "../../../commons/io/stream_char_destination.h"
+#include "../../../config/config.h"
 
 #include <sstream>
 
@@ -37,4 +38,30 @@ void test_group<test_data>::object::test<1>() {
 	ensure_equals("prueba", stream.str());
 }
 
+template<>
+template<>
+void test_group<test_data>::object::test<2>() {
+	set_test_name("Test writing spans mixed with single chars");
+
+	std::stringstream stream;
+	std::string expected;
+
+	{
+		commons::io::stream_char_destination destination(stream);
+
+		// Tramos chicos que se acumulan en el buffer, y uno más
+		// grande que el buffer que va directo al stream
+		std::string small("prueba");
+		std::string large(3 * CHAR_STREAM_BUFFER_SIZE / 2, 'x');
+		for (int i = 0; i < 3; i++) {
+			destination.write(reinterpret_cast<const unsigned char *>(small.data()), small.size());
+			destination.emit_char('-');
+			destination.write(reinterpret_cast<const unsigned char *>(large.data()), large.size());
+			expected += small + "-" + large;
+		}
+	}
+
+	ensure(expected == stream.str());
+}
+
 };
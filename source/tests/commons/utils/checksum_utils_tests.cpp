@@ -0,0 +1,37 @@
+#include "../../../dependencies/tut/tut.hpp"
+#include "../../../commons/utils/checksum_utils.h"
+#include <cstring>
+
+namespace {
+
+struct test_data {
+
+};
+
+tut::test_group<test_data> test_group("commons::utils::checksum functions unit tests");
+
+};
+
+namespace tut {
+
+template<>
+template<>
+void test_group<test_data>::object::test<1>() {
+	set_test_name("Test crc32 of known inputs");
+
+	const unsigned char *check = reinterpret_cast<const unsigned char *>("123456789");
+	ensure_equals(commons::utils::checksum::crc32(check, 0), 0u);
+	ensure_equals(commons::utils::checksum::crc32(check, 9), 0xCBF43926u);
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<2>() {
+	set_test_name("Test extending a crc32 in parts");
+
+	const unsigned char *check = reinterpret_cast<const unsigned char *>("123456789");
+	unsigned int partial = commons::utils::checksum::crc32(check, 4);
+	ensure_equals(commons::utils::checksum::crc32(check + 4, 5, partial), 0xCBF43926u);
+}
+
+};
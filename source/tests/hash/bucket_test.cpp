@@ -341,4 +341,39 @@ void test_group<test_data>::object::test<20>() {
 	ensure_equals(element_count, 3);
 }
 
+template<>
+template<>
+void test_group<test_data>::object::test<21>() {
+	set_test_name("Test finding elements after mixed insertions, updates and removals");
+
+	int keys[] = { 500, 100, 900, 300, 700, 200, 800, 400, 600 };
+	for (int i = 0; i < 9; i++) {
+		bucket.add_element(keys[i], std::string(1 + i, 'A' + i));
+	}
+
+	bucket.update_element(300, std::string(20, 'X'));
+	bucket.update_element(700, "Y");
+	bucket.remove_element(900);
+	bucket.remove_element(100);
+
+	ensure(!bucket.get_element(900).first);
+	ensure(!bucket.get_element(100).first);
+	ensure_equals(bucket.get_element(300).second, std::string(20, 'X'));
+	ensure_equals(bucket.get_element(700).second, "Y");
+	ensure_equals(bucket.get_element(500).second, "A");
+	ensure_equals(bucket.get_element(600).second, std::string(9, 'I'));
+
+	// Los elementos se recorren en el orden de sus claves
+	int previous_key = 0;
+	int element_count = 0;
+	for (bucket_iterator it = bucket.begin(); it != bucket.end(); it++) {
+		element_type e = *it;
+		ensure(previous_key < e.first);
+		ensure(bucket.get_element(e.first).first);
+		previous_key = e.first;
+		element_count++;
+	}
+	ensure_equals(element_count, 7);
+}
+
 };
@@ -1,7 +1,10 @@
 #include "../../dependencies/tut/tut.hpp"
 #include "../../hash/hash_container.h"
 #include "../../commons/log/log.h"
+#include "../../commons/io/ioexception.h"
+#include "../../commons/utils/stream_utils.h"
 #include <cstdio>
+#include <fstream>
 #include <vector>
 
 namespace {
@@ -603,5 +606,133 @@ void test_group<test_data>::object::test<8>() {
 		ensure_equals(res.first, false);
 }
 
-};
+template<>
+template<>
+void test_group<test_data>::object::test<9>() {
+	set_test_name("Test batched searches and upserts, with bucket overflows");
+
+	std::vector<key_type> keys;
+	std::vector<value_type> values;
+	for (int i = 0; i < 20; i++) {
+		keys.push_back(i * 3);
+		values.push_back(std::string(50 + i, 'A' + i));
+	}
+	container->upsert_elements(keys, values);
+
+	// La mitad de las claves se actualizan y se agregan otras nuevas
+	std::vector<key_type> other_keys;
+	std::vector<value_type> other_values;
+	for (int i = 10; i < 30; i++) {
+		other_keys.push_back(i * 3);
+		other_values.push_back(std::string(10, 'a' + i - 10));
+	}
+	container->upsert_elements(other_keys, other_values);
+
+	std::vector<key_type> searched_keys;
+	for (int i = 0; i < 31; i++) {
+		searched_keys.push_back(i * 3);
+	}
+	searched_keys.push_back(1);
+
+	std::vector<std::pair<bool, value_type> > results;
+	container->search_for_elements(searched_keys, results);
+
+	ensure_equals(results.size(), searched_keys.size());
+	for (int i = 0; i < 10; i++) {
+		ensure(results[i].first);
+		ensure_equals(results[i].second, std::string(50 + i, 'A' + i));
+	}
+	for (int i = 10; i < 30; i++) {
+		ensure(results[i].first);
+		ensure_equals(results[i].second, std::string(10, 'a' + i - 10));
+		ensure_equals(container->search_for_element(i * 3).second, results[i].second);
+	}
+	ensure(!results[30].first);
+	ensure(!results[31].first);
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<10>() {
+	set_test_name("Test opening read only");
+
+	for (int i = 0; i < 40; i++)
+		container->add_element(i, std::string(20, 'a' + i % 26));
+	delete container;
+	container = 0;
+	int index_size = commons::utils::streams::file_size("container_test.index");
+
+	container = new container_type("container_test.data", "container_test.index", block_size, commons::io::read_only);
+	for (int i = 0; i < 40; i++)
+		ensure_equals(container->search_for_element(i).second, std::string(20, 'a' + i % 26));
+	ensure(!container->search_for_element(40).first);
+
+	try {
+		container->add_element(40, "nuevo");
+		fail("A read only container was modified");
+	} catch (commons::io::ioexception &e) {
+
+	}
+
+	// La tabla no se vuelve a guardar al cerrar
+	delete container;
+	container = 0;
+	ensure_equals(commons::utils::streams::file_size("container_test.index"), index_size);
+	reopen();
+	ensure(!container->search_for_element(40).first);
+
+	try {
+		container_type missing("missing_container_test.data", "missing_container_test.index", block_size, commons::io::read_only);
+		fail("A missing read only container was created");
+	} catch (commons::io::ioexception &e) {
+
+	}
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<11>() {
+	set_test_name("Test temporary containers");
+
+	// Los archivos se pueden borrar apenas se abren
+	container_type *temporary = new container_type("temporary_container_test.data", "temporary_container_test.index",
+		block_size, commons::io::temporary);
+	std::remove("temporary_container_test.data");
+	std::remove("temporary_container_test.index");
+
+	for (int i = 0; i < 200; i++)
+		temporary->add_element(i, std::string(20, 'a' + i % 26));
+	for (int i = 0; i < 200; i++)
+		ensure_equals(temporary->search_for_element(i).second, std::string(20, 'a' + i % 26));
+
+	// Y la tabla no se guarda al cerrar
+	delete temporary;
+	ensure(!std::ifstream("temporary_container_test.index").is_open());
+	ensure(!std::ifstream("temporary_container_test.data").is_open());
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<12>() {
+	set_test_name("Test closing reports a table that could not be saved");
+
+	container_type *unsaved = new container_type("unsaved_container_test.data",
+		"missing_container_directory/unsaved_container_test.index", block_size);
+	unsaved->add_element(1, "uno");
+	try {
+		unsaved->close();
+		fail("Closing the container did not fail");
+	} catch (commons::io::ioexception &e) {
 
+	}
+	delete unsaved;
+	std::remove("unsaved_container_test.data");
+
+	// Con la tabla guardada, el contenedor se puede volver a abrir
+	container->add_element(1, "uno");
+	container->close();
+	reopen();
+	ensure_equals(container->search_for_element(1).second, "uno");
+}
+
+};
@@ -137,19 +137,22 @@ template<>
 void test_group<test_data>::object::test<2>() {
 	set_test_name("Test adding elements with overflow");
 
+	// Las claves están elegidas según los bits bajos de su hash, de
+	// manera que "f" y "b" caigan en un bucket y "c" en el otro
+
 	element_container expected_first_bucket_contents;
-	expected_first_bucket_contents.push_back(std::make_pair("0", std::string(200, 'A')));
-	expected_first_bucket_contents.push_back(std::make_pair("2", std::string(200, 'C')));
+	expected_first_bucket_contents.push_back(std::make_pair("f", std::string(200, 'A')));
+	expected_first_bucket_contents.push_back(std::make_pair("b", std::string(200, 'C')));
 	add_all_elements(expected_first_bucket_contents);
 
 	element_container expected_second_bucket_contents;
-	expected_second_bucket_contents.push_back(std::make_pair("1", std::string(200, 'B')));
+	expected_second_bucket_contents.push_back(std::make_pair("c", std::string(200, 'B')));
 	add_all_elements(expected_second_bucket_contents);
 
 	inspection i(close_for_inspection());
 	ensure_equals(i.table->get_size(), 2);
-	ensure_equals(i.table->get_key_position("0"), 1);
-	ensure_equals(i.table->get_key_position("1"), 0);
+	ensure_equals(i.table->get_key_position("f"), 1);
+	ensure_equals(i.table->get_key_position("c"), 0);
 
 	bucket_type b = i.buckets->get_bucket(0);
 	ensure_equals(b.get_hash_factor(), 2);
@@ -212,46 +215,49 @@ template<>
 void test_group<test_data>::object::test<6>() {
 	set_test_name("Test updating with overflow");
 
-	container->add_element("0", std::string(100, 'A'));
-	container->add_element("1", std::string(100, 'B'));
-	container->add_element("2", std::string(100, 'C'));
-	container->add_element("3", std::string(100, 'D'));
-	container->add_element("4", std::string(100, 'E'));
-	container->add_element("5", std::string(100, 'F'));
-	container->add_element("6", std::string(100, 'G'));
-	container->update_element("2", std::string(200, 'C'));
+	// Como en test<2>, las claves están elegidas según los bits
+	// bajos de su hash para forzar la distribución en buckets
+
+	container->add_element("f", std::string(100, 'A'));
+	container->add_element("c", std::string(100, 'B'));
+	container->add_element("b", std::string(100, 'C'));
+	container->add_element("a", std::string(100, 'D'));
+	container->add_element("l", std::string(100, 'E'));
+	container->add_element("g", std::string(100, 'F'));
+	container->add_element("d", std::string(100, 'G'));
+	container->update_element("b", std::string(200, 'C'));
 
 	inspection i(close_for_inspection());
 	ensure_equals(i.table->get_size(), 4);
-	ensure_equals(i.table->get_key_position("0"), 2);
-	ensure_equals(i.table->get_key_position("1"), 0);
-	ensure_equals(i.table->get_key_position("2"), 1);
-	ensure_equals(i.table->get_key_position("3"), 0);
-	ensure_equals(i.table->get_key_position("4"), 2);
-	ensure_equals(i.table->get_key_position("5"), 0);
-	ensure_equals(i.table->get_key_position("6"), 1);
+	ensure_equals(i.table->get_key_position("f"), 2);
+	ensure_equals(i.table->get_key_position("c"), 0);
+	ensure_equals(i.table->get_key_position("b"), 1);
+	ensure_equals(i.table->get_key_position("a"), 0);
+	ensure_equals(i.table->get_key_position("l"), 2);
+	ensure_equals(i.table->get_key_position("g"), 0);
+	ensure_equals(i.table->get_key_position("d"), 1);
 
 
 	element_container first_expected_bucket_contents;
-	first_expected_bucket_contents.push_back(std::make_pair("1", std::string(100, 'B')));
-	first_expected_bucket_contents.push_back(std::make_pair("3", std::string(100, 'D')));
-	first_expected_bucket_contents.push_back(std::make_pair("5", std::string(100, 'F')));
+	first_expected_bucket_contents.push_back(std::make_pair("c", std::string(100, 'B')));
+	first_expected_bucket_contents.push_back(std::make_pair("a", std::string(100, 'D')));
+	first_expected_bucket_contents.push_back(std::make_pair("g", std::string(100, 'F')));
 
 	bucket_type b = i.buckets->get_bucket(0);
 	ensure_equals(b.get_hash_factor(), 2);
 	ensure_bucket_contents(b, first_expected_bucket_contents);
 
 	element_container second_expected_bucket_contents;
-	second_expected_bucket_contents.push_back(std::make_pair("2", std::string(200, 'C')));
-	second_expected_bucket_contents.push_back(std::make_pair("6", std::string(100, 'G')));
+	second_expected_bucket_contents.push_back(std::make_pair("b", std::string(200, 'C')));
+	second_expected_bucket_contents.push_back(std::make_pair("d", std::string(100, 'G')));
 
 	b = i.buckets->get_bucket(1);
 	ensure_equals(b.get_hash_factor(), 4);
 	ensure_bucket_contents(b, second_expected_bucket_contents);
 
 	element_container third_expected_bucket_contents;
-	third_expected_bucket_contents.push_back(std::make_pair("0", std::string(100, 'A')));
-	third_expected_bucket_contents.push_back(std::make_pair("4", std::string(100, 'E')));
+	third_expected_bucket_contents.push_back(std::make_pair("f", std::string(100, 'A')));
+	third_expected_bucket_contents.push_back(std::make_pair("l", std::string(100, 'E')));
 
 	b = i.buckets->get_bucket(2);
 	ensure_equals(b.get_hash_factor(), 4);
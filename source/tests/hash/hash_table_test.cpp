@@ -1,5 +1,7 @@
 #include "../../dependencies/tut/tut.hpp"
 #include "../../hash/hash_table.h"
+#include <fstream>
+#include <cstdio>
 
 namespace {
 
@@ -232,4 +234,98 @@ void test_group<test_data>::object::test<8>() {
 	ensure_equals(table->get_key_position(7), 0);
 }
 
+template<>
+template<>
+void test_group<test_data>::object::test<9>() {
+	set_test_name("Test checkpoint writes the whole table sequentially");
+
+	table->grow();
+	table->remap_last_used_entry(1, 1);
+	table->get_key_position(1);
+	table->grow();
+	table->remap_last_used_entry(2, 2);
+	table->checkpoint();
+
+	// El tamaño de la tabla seguido de cada una de las entradas
+	std::ifstream file("hash_table_test", std::ios_base::in | std::ios_base::binary);
+	int contents[5];
+	file.read(reinterpret_cast<char *>(contents), sizeof(contents));
+	ensure(file.good());
+	ensure_equals(file.get(), EOF);
+
+	ensure_equals(contents[0], 4);
+	ensure_equals(contents[1], 1);
+	ensure_equals(contents[2], 2);
+	ensure_equals(contents[3], 1);
+	ensure_equals(contents[4], 0);
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<10>() {
+	set_test_name("Test positions from precomputed hashes match key positions");
+
+	table->grow();
+	table->remap_last_used_entry(1, 1);
+	table->get_key_position(1);
+	table->grow();
+	table->remap_last_used_entry(2, 2);
+
+	// Las claves int se hashean a sí mismas
+	for (int i = 0; i < 100; i++)
+		ensure_equals(table->get_hash_position(hash::hash_key(i)), table->get_key_position(i));
+
+	// El hash de un string es el de sus chars en orden, que es lo
+	// que calcula incrementalmente el buffer de contextos
+	{
+		hash::hash_table<std::string> string_table("hash_table_string_test");
+		string_table.grow();
+		string_table.remap_last_used_entry(1, 1);
+
+		const char *keys[] = { "", "a", "ab", "abc", "casa", "perro" };
+		for (unsigned int i = 0; i < sizeof(keys) / sizeof(keys[0]); i++) {
+			std::string key(keys[i]);
+			unsigned int state = commons::utils::hashing::initial_state;
+			for (std::string::size_type j = 0; j < key.size(); j++)
+				state = commons::utils::hashing::extend_state(state, key[j]);
+
+			ensure_equals(hash::hash_key(key), commons::utils::hashing::finish_state(state));
+			ensure_equals(string_table.get_hash_position(hash::hash_key(key)), string_table.get_key_position(key));
+		}
+	}
+	std::remove("hash_table_string_test");
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<11>() {
+	set_test_name("Test failing to save the table is reported");
+
+	table_type *unsaved = new table_type("missing_hash_table_directory/hash_table_test");
+	unsaved->grow();
+	try {
+		unsaved->checkpoint();
+		fail("Saving the table did not fail");
+	} catch (commons::io::ioexception &e) {
+
+	}
+	try {
+		unsaved->close();
+		fail("Closing the table did not fail");
+	} catch (commons::io::ioexception &e) {
+
+	}
+
+	// El destructor no eleva
+	delete unsaved;
+
+	// Cerrada, la tabla ya no se vuelve a guardar
+	table->grow();
+	table->close();
+	std::remove("hash_table_test");
+	delete table;
+	table = 0;
+	ensure(!std::ifstream("hash_table_test").is_open());
+}
+
 };
@@ -0,0 +1,165 @@
+#include "../../dependencies/tut/tut.hpp"
+#include "../../overlay/overlay_container.h"
+#include "../../trie/trie_container.h"
+#include <map>
+
+namespace {
+
+typedef std::string key_type;
+typedef int value_type;
+typedef trie::trie_container<value_type> layer_type;
+typedef overlay::overlay_container<key_type, value_type> container_type;
+typedef container_type::duplicate_exception duplicate;
+typedef container_type::not_found_exception not_found;
+
+struct collector : public container::element_inspector<key_type, value_type> {
+	std::map<key_type, value_type> elements;
+
+	virtual void inspect(const key_type &key, const value_type &value) {
+		elements[key] = value;
+	}
+};
+
+struct test_data {
+	layer_type base;
+	layer_type delta;
+	container_type container;
+
+	test_data() : base(1024 * 1024), delta(1024 * 1024), container(&base, &delta) {
+		base.add_element("casa", 1);
+		base.add_element("asa", 2);
+		base.add_element("cosa", 3);
+	}
+
+	void ensure_element(const key_type &key, value_type value) {
+		std::pair<bool, value_type> result = container.search_for_element(key);
+		tut::ensure(result.first);
+		tut::ensure_equals(result.second, value);
+	}
+
+	void ensure_no_element(const key_type &key) {
+		tut::ensure(!container.search_for_element(key).first);
+	}
+};
+
+tut::test_group<test_data> test_group("overlay::overlay_container class unit tests");
+
+};
+
+namespace tut {
+
+template<>
+template<>
+void test_group<test_data>::object::test<1>() {
+	set_test_name("Test searching through both layers");
+
+	container.add_element("masa", 4);
+
+	ensure_element("casa", 1);
+	ensure_element("masa", 4);
+	ensure_no_element("sa");
+	ensure(!base.search_for_element("masa").first);
+
+	try {
+		container.add_element("asa", 5);
+		fail("Duplicate exception not caught");
+	} catch (duplicate &d) {
+
+	}
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<2>() {
+	set_test_name("Test modifications never reach the base");
+
+	container.update_element("casa", 10);
+	container.upsert_element("cosa", 30);
+	container.upsert_element("rosa", 40);
+
+	ensure_element("casa", 10);
+	ensure_element("cosa", 30);
+	ensure_element("rosa", 40);
+	ensure_equals(base.search_for_element("casa").second, 1);
+	ensure_equals(base.search_for_element("cosa").second, 3);
+	ensure(!base.search_for_element("rosa").first);
+
+	try {
+		container.update_element("sa", 5);
+		fail("Not found exception not caught");
+	} catch (not_found &n) {
+
+	}
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<3>() {
+	set_test_name("Test deleting elements of both layers");
+
+	container.update_element("casa", 10);
+	container.delete_element("casa");
+	container.delete_element("asa");
+
+	ensure_no_element("casa");
+	ensure_no_element("asa");
+	ensure(base.search_for_element("asa").first);
+
+	try {
+		container.delete_element("asa");
+		fail("Not found exception not caught");
+	} catch (not_found &n) {
+
+	}
+
+	// Un elemento eliminado se puede volver a agregar
+	container.add_element("asa", 20);
+	ensure_element("asa", 20);
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<4>() {
+	set_test_name("Test batch searches and upserts");
+
+	std::vector<key_type> keys;
+	keys.push_back("cosa");
+	keys.push_back("rosa");
+	keys.push_back("asa");
+	keys.push_back("sa");
+	std::vector<value_type> values;
+	values.push_back(30);
+	values.push_back(40);
+
+	container.delete_element("asa");
+	container.upsert_elements(std::vector<key_type>(keys.begin(), keys.begin() + 2), values);
+
+	std::vector<container_type::search_result_type> results;
+	container.search_for_elements(keys, results);
+	ensure_equals(results.size(), 4u);
+	ensure(results[0].first);
+	ensure_equals(results[0].second, 30);
+	ensure(results[1].first);
+	ensure_equals(results[1].second, 40);
+	ensure(!results[2].first);
+	ensure(!results[3].first);
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<5>() {
+	set_test_name("Test inspecting both layers");
+
+	container.update_element("casa", 10);
+	container.add_element("rosa", 4);
+	container.delete_element("asa");
+
+	collector c;
+	container.inspect(c);
+	ensure_equals(c.elements.size(), 3u);
+	ensure_equals(c.elements["casa"], 10);
+	ensure_equals(c.elements["cosa"], 3);
+	ensure_equals(c.elements["rosa"], 4);
+}
+
+};
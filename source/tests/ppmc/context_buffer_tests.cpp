@@ -1,5 +1,6 @@
 #include "../../dependencies/tut/tut.hpp"
 #include "../../ppmc/context_buffer.h"
+#include "../../commons/utils/hash_utils.h"
 
 using namespace ppmc;
 
@@ -90,4 +91,23 @@ void test_group<test_data>::object::test<3>() {
 	ensure_equals(buffer.get_context(5), "cdefg");
 }
 
+template<>
+template<>
+void test_group<test_data>::object::test<4>() {
+	set_test_name("Test context views and hashes of a cyclic buffer");
+
+	std::string text = "abracadabra";
+	for (std::string::size_type i = 0; i < text.size(); i++) {
+		buffer.push_char(text[i]);
+
+		for (unsigned int k = 1; k <= buffer.max_context(); k++) {
+			std::string expected = text.substr(i + 1 - k, k);
+			context_buffer::context_view view = buffer.get_context_view(k);
+
+			ensure_equals(view.str(), expected);
+			ensure_equals(buffer.get_context_hash(k), commons::utils::hashing::hash_string(expected));
+		}
+	}
+}
+
 };
@@ -0,0 +1,193 @@
+#include "../../dependencies/tut/tut.hpp"
+#include "../../ppmc/dictionary.h"
+#include "../../ppmc/dictionary_container_factory.h"
+#include "../../ppmc/compressor.h"
+#include "../../ppmc/decompressor.h"
+#include "../../commons/io/memory_char_source.h"
+#include "../../commons/io/memory_char_destination.h"
+#include "../../commons/io/stream_binary_source.h"
+#include "../../commons/io/stream_binary_destination.h"
+#include "../../trie/trie_container.h"
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ppmc;
+
+namespace {
+
+typedef context_container_factory::context_container context_container;
+
+/**
+ * Fábrica de tries que "abre" siempre el mismo diccionario en memoria
+ */
+struct trie_factory : public context_container_factory {
+	context_container *stored;
+
+	trie_factory() : stored(new trie::trie_container<arithmetic::symbol_distribution>(1024 * 1024)) {}
+
+	~trie_factory() {
+		delete stored;
+	}
+
+	virtual context_container *create_container() {
+		return new trie::trie_container<arithmetic::symbol_distribution>(1024 * 1024);
+	}
+
+	virtual void destroy_container(context_container *container) {
+		if (container != stored)
+			delete container;
+	}
+
+	virtual context_container *open_container(const std::string &path, commons::io::open_mode mode) {
+		return stored;
+	}
+};
+
+struct test_data {
+	trie_factory factory;
+	dictionary_container_factory dictionary_factory;
+
+	test_data() : dictionary_factory("dictionary", factory, factory) {
+
+	}
+
+	std::string text(int first, int count) {
+		std::stringstream builder;
+		for (int i = first; i < first + count; i++)
+			builder << "{\"linea\": " << i << ", \"texto\": \"el veloz murcielago hindu comia feliz cardillo y kiwi\"}\n";
+		return builder.str();
+	}
+
+	void train(const std::string &corpus, context_container *container) {
+		commons::io::memory_char_source source(reinterpret_cast<const unsigned char *>(corpus.data()), corpus.size());
+		dictionary::train(source, 3, container);
+	}
+
+	std::string compress(context_container *container, const std::string &chars) {
+		std::ostringstream output(std::ios_base::out | std::ios_base::binary);
+		{
+			commons::io::stream_binary_destination destination(output);
+			commons::io::memory_char_source source(reinterpret_cast<const unsigned char *>(chars.data()), chars.size());
+			compressor c(destination, 3, container);
+			c.compress(source);
+		}
+		return output.str();
+	}
+
+	std::string compress(context_container_factory &f, const std::string &chars) {
+		context_container *container = f.create_container();
+		std::string compressed = compress(container, chars);
+		f.destroy_container(container);
+		return compressed;
+	}
+
+	std::string decompress(context_container_factory &f, const std::string &compressed) {
+		context_container *container = f.create_container();
+		std::string chars = decompress(container, compressed);
+		f.destroy_container(container);
+		return chars;
+	}
+
+	std::string decompress(context_container *container, const std::string &compressed) {
+		std::istringstream input(compressed, std::ios_base::in | std::ios_base::binary);
+		std::vector<unsigned char> chars;
+		{
+			commons::io::stream_binary_source source(input);
+			commons::io::memory_char_destination destination(chars);
+			decompressor d(source, 3, container);
+			d.decompress(destination);
+		}
+		return std::string(chars.begin(), chars.end());
+	}
+};
+
+tut::test_group<test_data> test_group("ppmc::dictionary unit tests");
+
+};
+
+namespace tut {
+
+template<>
+template<>
+void test_group<test_data>::object::test<1>() {
+	set_test_name("Test compressing with a trained model");
+
+	// Compresor y descompresor parten de modelos entrenados
+	// con el mismo corpus
+	train(text(0, 200), factory.stored);
+	context_container *copy = factory.create_container();
+	train(text(0, 200), copy);
+
+	std::string chars = text(500, 3);
+	context_container *empty = factory.create_container();
+	std::string without_dictionary = compress(empty, chars);
+	std::string with_dictionary = compress(factory.stored, chars);
+	ensure(with_dictionary.size() < without_dictionary.size() / 2);
+
+	ensure_equals(decompress(copy, with_dictionary), chars);
+	factory.destroy_container(empty);
+	factory.destroy_container(copy);
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<2>() {
+	set_test_name("Test the trained model holds context zero");
+
+	std::vector<std::string> keys;
+	keys.push_back("");
+	std::vector<context_container::search_result_type> results;
+
+	factory.stored->search_for_elements(keys, results);
+	ensure(!results[0].first);
+
+	train(text(0, 50), factory.stored);
+	results.clear();
+	factory.stored->search_for_elements(keys, results);
+	ensure(results[0].first);
+	ensure(results[0].second.get_total_frequency() > 0u);
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<3>() {
+	set_test_name("Test compressing with a dictionary overlay");
+
+	train(text(0, 200), factory.stored);
+	std::string chars = text(500, 3);
+
+	std::string with_dictionary = compress(dictionary_factory, chars);
+	std::string without_dictionary = compress(factory, chars);
+	ensure(with_dictionary.size() < without_dictionary.size() / 2);
+
+	ensure_equals(decompress(dictionary_factory, with_dictionary), chars);
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<4>() {
+	set_test_name("Test the dictionary is not modified");
+
+	train(text(0, 50), factory.stored);
+
+	std::vector<std::string> keys;
+	keys.push_back("");
+	keys.push_back("ki");
+	keys.push_back("wi\n");
+	std::vector<context_container::search_result_type> before;
+	factory.stored->search_for_elements(keys, before);
+	ensure(before[0].first);
+
+	std::string compressed = compress(dictionary_factory, text(100, 10));
+	decompress(dictionary_factory, compressed);
+
+	std::vector<context_container::search_result_type> after;
+	factory.stored->search_for_elements(keys, after);
+	for (unsigned int i = 0; i < keys.size(); i++) {
+		ensure_equals(after[i].first, before[i].first);
+		ensure_equals(after[i].second.get_total_frequency(), before[i].second.get_total_frequency());
+	}
+}
+
+};
@@ -0,0 +1,103 @@
+#include "../../dependencies/tut/tut.hpp"
+#include "../../ppmc/distribution_arena.h"
+#include "../../trie/trie_container.h"
+
+using namespace ppmc;
+
+namespace {
+
+typedef arithmetic::symbol_distribution distribution_type;
+
+/**
+ * Contenedor en memoria que cuenta las búsquedas que recibe
+ */
+struct counting_container : public trie::trie_container<distribution_type> {
+	int searches;
+
+	counting_container() : trie::trie_container<distribution_type>(1024 * 1024), searches(0) {}
+
+	virtual std::pair<bool, distribution_type> search_for_element(const std::string &key) {
+		searches++;
+		return trie::trie_container<distribution_type>::search_for_element(key);
+	}
+};
+
+struct test_data {
+	context_buffer buffer;
+	distribution_arena arena;
+	counting_container container;
+
+	test_data() : buffer(3), arena(3) {
+
+	}
+
+	void push_and_store(unsigned char c) {
+		arena.load(buffer, container);
+		for (unsigned int i = 0; i < arena.size(); i++)
+			arena[i].register_symbol_emision(arithmetic::symbol::for_char(c));
+		arena.store(container);
+		buffer.push_char(c);
+	}
+};
+
+tut::test_group<test_data> test_group("ppmc::distribution_arena class unit tests");
+
+};
+
+namespace tut {
+
+template<>
+template<>
+void test_group<test_data>::object::test<1>() {
+	set_test_name("Test loading and storing distributions");
+
+	push_and_store('a');
+	push_and_store('b');
+	push_and_store('c');
+
+	arena.load(buffer, container);
+	ensure_equals(arena.size(), 3u);
+	ensure_equals(arena.get_context(0), "c");
+	ensure_equals(arena.get_context(1), "bc");
+	ensure_equals(arena.get_context(2), "abc");
+
+	// Los contextos "c" y "bc" no se registraron todavía
+	ensure(!arena[0].has_symbol(arithmetic::symbol::for_char('c')));
+	ensure(!arena[2].has_symbol(arithmetic::symbol::for_char('c')));
+
+	push_and_store('a');
+	push_and_store('b');
+	push_and_store('c');
+	arena.load(buffer, container);
+	ensure_equals(arena[0].get_emissions(arithmetic::symbol::for_char('a')), 1u);
+	ensure_equals(arena[1].get_emissions(arithmetic::symbol::for_char('a')), 1u);
+	ensure_equals(container.search_for_element("b").second.get_emissions(arithmetic::symbol::for_char('c')), 2u);
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<2>() {
+	set_test_name("Test repeated contexts are not searched again");
+
+	for (int i = 0; i < 4; i++)
+		push_and_store('a');
+
+	// A partir de acá todos los contextos son iguales a los de
+	// la posición anterior, así que no se buscan más
+	int searches = container.searches;
+	push_and_store('a');
+	push_and_store('a');
+	ensure_equals(container.searches, searches);
+
+	arena.load(buffer, container);
+	ensure_equals(arena[2].get_emissions(arithmetic::symbol::for_char('a')), 3u);
+	ensure_equals(arena[0].get_emissions(arithmetic::symbol::for_char('a')), 5u);
+
+	// Un char distinto cambia todos los contextos
+	push_and_store('b');
+	arena.load(buffer, container);
+	ensure_equals(container.searches, searches + 3);
+	ensure_equals(arena.get_context(0), "b");
+}
+
+};
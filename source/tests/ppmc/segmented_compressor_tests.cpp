@@ -0,0 +1,239 @@
+#include "../../dependencies/tut/tut.hpp"
+#include "../../ppmc/segmented_compressor.h"
+#include "../../ppmc/segmented_decompressor.h"
+#include "../../ppmc/segmented_format.h"
+#include "../../commons/io/memory_char_source.h"
+#include "../../commons/io/memory_char_destination.h"
+#include "../../commons/io/ioexception.h"
+#include "../../trie/trie_container.h"
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ppmc;
+
+namespace {
+
+struct trie_factory : public context_container_factory {
+	virtual context_container *create_container() {
+		return new trie::trie_container<arithmetic::symbol_distribution>(1024 * 1024);
+	}
+
+	virtual void destroy_container(context_container *container) {
+		delete container;
+	}
+};
+
+struct test_data {
+	trie_factory factory;
+	commons::concurrency::thread_pool pool;
+	std::string text;
+
+	test_data() : pool(3) {
+		std::stringstream builder;
+		for (int i = 0; i < 400; i++)
+			builder << "linea " << i << ": el veloz murcielago hindu comia feliz cardillo y kiwi\n";
+		text = builder.str();
+	}
+
+	std::string compress(unsigned int segment_size) {
+		std::ostringstream output(std::ios_base::out | std::ios_base::binary);
+		commons::io::memory_char_source source(reinterpret_cast<const unsigned char *>(text.data()), text.size());
+		segmented_compressor compressor(output, 3, segment_size, factory, pool);
+		compressor.compress(source);
+		return output.str();
+	}
+
+	std::string decompress(const std::string &compressed) {
+		std::istringstream input(compressed, std::ios_base::in | std::ios_base::binary);
+		std::vector<unsigned char> chars;
+		commons::io::memory_char_destination destination(chars);
+		segmented_decompressor decompressor(input, factory, pool);
+		decompressor.decompress(destination);
+		return std::string(chars.begin(), chars.end());
+	}
+
+	std::string decompress_range(const std::string &compressed, uint64_t start, uint64_t length) {
+		std::istringstream input(compressed, std::ios_base::in | std::ios_base::binary);
+		std::vector<unsigned char> chars;
+		commons::io::memory_char_destination destination(chars);
+		segmented_decompressor decompressor(input, factory, pool);
+		decompressor.decompress_range(destination, start, length);
+		return std::string(chars.begin(), chars.end());
+	}
+};
+
+tut::test_group<test_data> test_group("ppmc::segmented_compressor class unit tests");
+
+};
+
+namespace tut {
+
+template<>
+template<>
+void test_group<test_data>::object::test<1>() {
+	set_test_name("Test compressing and decompressing many segments");
+
+	std::string compressed = compress(1000);
+
+	std::istringstream input(compressed);
+	ensure(segmented::is_segmented(input));
+	segmented::header h = segmented::read_header(input);
+	ensure_equals(h.max_contexts, 3u);
+	ensure_equals(h.segment_size, 1000u);
+
+	segmented::frame first = segmented::read_frame(input);
+	ensure_equals(first.uncompressed_size, 1000u);
+	ensure(first.compressed_size < first.uncompressed_size);
+
+	ensure(compressed.size() < text.size());
+	ensure_equals(decompress(compressed), text);
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<2>() {
+	set_test_name("Test empty input and a single segment");
+
+	std::string full_text = text;
+	text.clear();
+	ensure_equals(decompress(compress(1000)), "");
+
+	text = full_text;
+	ensure_equals(decompress(compress(text.size() * 2)), text);
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<3>() {
+	set_test_name("Test corrupted segments are detected");
+
+	std::string compressed = compress(1000);
+
+	// Altero el CRC del primer frame, que está después del encabezado
+	// de 10 bytes y de los dos tamaños
+	compressed[18] ^= 0x5A;
+	try {
+		decompress(compressed);
+		fail("Should have detected the checksum mismatch");
+	} catch (commons::io::ioexception &e) {
+		ensure_equals(std::string(e.what()), "Checksum mismatch in segment 0");
+	}
+
+	// Un archivo truncado también se detecta
+	try {
+		decompress(compress(1000).substr(0, 200));
+		fail("Should have detected the truncated file");
+	} catch (commons::io::ioexception &e) {
+
+	}
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<4>() {
+	set_test_name("Test the segment index");
+
+	std::string compressed = compress(1000);
+	std::istringstream input(compressed);
+	segmented::segment_index segments = segmented::read_index(input);
+	ensure_equals(segments.size(), (text.size() + 999) / 1000);
+
+	for (unsigned int i = 0; i < segments.size(); i++) {
+		ensure_equals(segments[i].uncompressed_offset, i * 1000u);
+
+		input.seekg(segments[i].frame_offset);
+		segmented::frame f = segmented::read_frame(input);
+		ensure_equals(f.uncompressed_size, std::min<std::string::size_type>(1000, text.size() - i * 1000));
+	}
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<5>() {
+	set_test_name("Test decompressing ranges");
+
+	std::string compressed = compress(1000);
+
+	ensure_equals(decompress_range(compressed, 0, 10), text.substr(0, 10));
+	ensure_equals(decompress_range(compressed, 990, 20), text.substr(990, 20));
+	ensure_equals(decompress_range(compressed, 3000, 1000), text.substr(3000, 1000));
+	ensure_equals(decompress_range(compressed, 1500, 5200), text.substr(1500, 5200));
+	ensure_equals(decompress_range(compressed, text.size() - 5, 100), text.substr(text.size() - 5));
+	ensure_equals(decompress_range(compressed, text.size() + 5, 100), "");
+	ensure_equals(decompress_range(compressed, 10, 0), "");
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<6>() {
+	set_test_name("Test corrupted frame sizes and indexes are detected");
+
+	std::string compressed = compress(1000);
+
+	// Un frame que dice tener casi 4 GB comprimidos no se reserva
+	// de antemano; el archivo termina antes
+	std::string huge_frame = compressed;
+	huge_frame[14] = huge_frame[15] = huge_frame[16] = huge_frame[17] = '\xFF';
+	try {
+		decompress(huge_frame);
+		fail("Should have detected the truncated segment");
+	} catch (commons::io::ioexception &e) {
+		ensure_equals(std::string(e.what()), "Truncated segmented file");
+	}
+
+	// Ni uno más grande que el tamaño de segmento del encabezado
+	std::string long_frame = compressed;
+	long_frame[11] = '\x7F';
+	try {
+		decompress(long_frame);
+		fail("Should have detected the oversized segment");
+	} catch (commons::io::ioexception &e) {
+		ensure_equals(std::string(e.what()), "Corrupt segmented file frame");
+	}
+
+	// La cantidad de entradas del pie tiene que coincidir con el
+	// lugar que ocupa el índice
+	std::string huge_index = compressed;
+	huge_index[huge_index.size() - 13] = '\x7F';
+	try {
+		decompress_range(huge_index, 0, 10);
+		fail("Should have detected the corrupt index");
+	} catch (commons::io::ioexception &e) {
+		ensure_equals(std::string(e.what()), "Corrupt segmented file index");
+	}
+
+	// Y las entradas tienen que estar ordenadas: la última pasa a
+	// empezar en 0
+	std::string unordered_index = compressed;
+	unordered_index.replace(unordered_index.size() - 16 - 16, 8, 8, '\0');
+	try {
+		decompress_range(unordered_index, 0, 10);
+		fail("Should have detected the unordered index");
+	} catch (commons::io::ioexception &e) {
+		ensure_equals(std::string(e.what()), "Corrupt segmented file index");
+	}
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<7>() {
+	set_test_name("Test segment sizes beyond the input and the contexts limit");
+
+	// El buffer de cada segmento crece con la entrada, así que un
+	// tamaño de segmento de 1 GB no reserva 1 GB
+	ensure_equals(decompress(compress(1024 * 1024 * 1024)), text);
+
+	// El máximo de contextos tiene que entrar en el encabezado
+	std::ostringstream output(std::ios_base::out | std::ios_base::binary);
+	commons::io::memory_char_source source(reinterpret_cast<const unsigned char *>(text.data()), text.size());
+	segmented_compressor compressor(output, segmented::max_contexts_limit + 1, 1000, factory, pool);
+	try {
+		compressor.compress(source);
+		fail("Should have rejected the maximum number of contexts");
+	} catch (commons::io::ioexception &e) {
+
+	}
+}
+
+};
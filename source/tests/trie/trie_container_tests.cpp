@@ -0,0 +1,259 @@
+#include "../../dependencies/tut/tut.hpp"
+#include "../../trie/trie_container.h"
+#include <map>
+#include <sstream>
+
+namespace {
+
+typedef std::string key_type;
+typedef int value_type;
+typedef trie::trie_container<value_type> container_type;
+typedef container_type::duplicate_exception duplicate;
+typedef container_type::not_found_exception not_found;
+
+/**
+ * Valor que dice alocar aparte tantos bytes como su tamaño
+ */
+struct allocating_value {
+	unsigned int size;
+
+	allocating_value(unsigned int size = 0) : size(size) {}
+};
+
+unsigned int heap_size_of(const allocating_value &value) {
+	return value.size;
+}
+
+unsigned int used_memory(trie::trie_container<allocating_value> &container) {
+	std::stringstream dump;
+	container.dump_to_stream(dump);
+	std::string line;
+	while (std::getline(dump, line) && line.find("Memoria utilizada (b): ") != 0);
+
+	unsigned int used = 0;
+	std::stringstream(line.substr(line.find(':') + 1)) >> used;
+	return used;
+}
+
+std::ostream &operator<<(std::ostream &output, const allocating_value &value) {
+	return output << value.size;
+}
+
+struct collector : public container::element_inspector<key_type, value_type> {
+	std::map<key_type, value_type> elements;
+
+	virtual void inspect(const key_type &key, const value_type &value) {
+		elements[key] = value;
+	}
+};
+
+struct test_data {
+	container_type container;
+
+	test_data() : container(1024 * 1024) {
+
+	}
+
+	void ensure_element(const key_type &key, value_type value) {
+		std::pair<bool, value_type> result = container.search_for_element(key);
+		tut::ensure(result.first);
+		tut::ensure_equals(result.second, value);
+	}
+
+	void ensure_no_element(const key_type &key) {
+		tut::ensure(!container.search_for_element(key).first);
+	}
+};
+
+tut::test_group<test_data> test_group("trie::trie_container class unit tests");
+
+};
+
+namespace tut {
+
+template<>
+template<>
+void test_group<test_data>::object::test<1>() {
+	set_test_name("Test adding and searching elements");
+
+	container.add_element("casa", 1);
+	container.add_element("asa", 2);
+	container.add_element("cosa", 3);
+	container.add_element("", 4);
+
+	ensure_element("casa", 1);
+	ensure_element("asa", 2);
+	ensure_element("cosa", 3);
+	ensure_element("", 4);
+	ensure_no_element("sa");
+	ensure_no_element("a");
+	ensure_no_element("ccasa");
+	ensure_no_element("masa");
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<2>() {
+	set_test_name("Test adding duplicate elements");
+
+	container.add_element("casa", 1);
+	container.add_element("asa", 2);
+
+	try {
+		container.add_element("casa", 5);
+		fail("Duplicate exception not caught");
+	} catch (duplicate &d) {
+
+	}
+	ensure_element("casa", 1);
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<3>() {
+	set_test_name("Test updating and deleting elements");
+
+	container.add_element("casa", 1);
+	container.add_element("asa", 2);
+
+	container.update_element("asa", 7);
+	ensure_element("asa", 7);
+	ensure_element("casa", 1);
+
+	try {
+		container.update_element("sa", 5);
+		fail("Not found exception not caught");
+	} catch (not_found &n) {
+
+	}
+
+	container.delete_element("casa");
+	ensure_no_element("casa");
+	ensure_element("asa", 7);
+
+	try {
+		container.delete_element("casa");
+		fail("Not found exception not caught");
+	} catch (not_found &n) {
+
+	}
+
+	container.add_element("casa", 9);
+	ensure_element("casa", 9);
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<4>() {
+	set_test_name("Test accessing every suffix of a context in any order");
+
+	// Simula el acceso del compresor PPMC: primero el contexto
+	// más largo y después sus sufijos, intercalando otras claves
+	container.add_element("c", 1);
+	container.add_element("bc", 2);
+	ensure_no_element("abc");
+	container.add_element("abc", 3);
+	ensure_element("bc", 2);
+	ensure_element("c", 1);
+	container.add_element("xbc", 4);
+	ensure_element("abc", 3);
+	ensure_element("xbc", 4);
+	ensure_no_element("yxbc");
+	ensure_element("c", 1);
+	container.update_element("bc", 5);
+	ensure_element("abc", 3);
+	ensure_element("bc", 5);
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<5>() {
+	set_test_name("Test inspecting elements");
+
+	container.add_element("casa", 1);
+	container.add_element("asa", 2);
+	container.add_element("cosa", 3);
+	container.add_element("perro", 4);
+	container.delete_element("cosa");
+
+	collector c;
+	container.inspect(c);
+
+	ensure_equals(c.elements.size(), 3u);
+	ensure_equals(c.elements["casa"], 1);
+	ensure_equals(c.elements["asa"], 2);
+	ensure_equals(c.elements["perro"], 4);
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<6>() {
+	set_test_name("Test restarting when the memory limit is reached");
+
+	container_type small_container(1024);
+
+	// Agrego claves hasta que el contenedor se reinicia
+	for (int i = 0; i < 200; i++) {
+		std::string current(1, static_cast<char>('a' + i % 26));
+		current += static_cast<char>(i);
+		small_container.add_element(current, i);
+		ensure(small_container.search_for_element(current).first);
+	}
+
+	collector c;
+	small_container.inspect(c);
+	ensure(c.elements.size() < 200u);
+	ensure(c.elements.size() > 0u);
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<7>() {
+	set_test_name("Test counting reserved memory against the limit");
+
+	container_type small_container(4096);
+
+	// La memoria reservada por los vectores nunca pasa del límite,
+	// aunque crezcan de a más de un elemento
+	for (int i = 0; i < 2000; i++) {
+		std::stringstream key;
+		key << i * 7919;
+		small_container.add_element(key.str(), i);
+
+		std::stringstream dump;
+		small_container.dump_to_stream(dump);
+		std::string line;
+		while (std::getline(dump, line) && line.find("Memoria utilizada (b): ") != 0);
+
+		unsigned int used = 0;
+		std::stringstream(line.substr(line.find(':') + 1)) >> used;
+		ensure(used > 0);
+		ensure(used <= 4096);
+	}
+}
+
+template<>
+template<>
+void test_group<test_data>::object::test<8>() {
+	set_test_name("Test counting memory allocated by the values");
+
+	trie::trie_container<allocating_value> allocating(8192);
+	allocating.add_element("a", allocating_value(1000));
+	unsigned int with_small_value = used_memory(allocating);
+	allocating.update_element("a", allocating_value(3000));
+	ensure_equals(used_memory(allocating), with_small_value + 2000);
+	allocating.upsert_element("a", allocating_value(500));
+	ensure_equals(used_memory(allocating), with_small_value - 500);
+
+	// Los valores grandes llenan el contenedor mucho antes que
+	// sus nodos
+	allocating.add_element("b", allocating_value(3000));
+	allocating.add_element("c", allocating_value(3000));
+	ensure(allocating.search_for_element("b").first);
+	allocating.add_element("d", allocating_value(3000));
+	ensure(!allocating.search_for_element("b").first);
+	ensure(allocating.search_for_element("d").first);
+	ensure(used_memory(allocating) <= 8192);
+}
+
+};
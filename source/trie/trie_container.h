@@ -0,0 +1,342 @@
+/******************************************************************************
+ * trie_container.h
+ * 		Declaraciones y definiciones de la clase trie::trie_container
+******************************************************************************/
+#ifndef __TRIE_TRIE_CONTAINER_H_INCLUDED__
+#define __TRIE_TRIE_CONTAINER_H_INCLUDED__
+
+#include "../associative_container.h"
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <utility>
+#include <iostream>
+
+namespace trie {
+
+/**
+ * Memoria que un valor aloca aparte de su instancia. Los tipos que
+ * alocan memoria definen una sobrecarga de heap_size_of en su propio
+ * namespace, que el trie encuentra por ADL; el resto no aloca nada.
+ */
+template<typename T>
+unsigned int heap_size_of(const T &value) {
+	return 0;
+}
+
+/**
+ * Contenedor de elementos en memoria, organizado como un trie
+ * sobre las claves leídas de atrás para adelante. De esta manera
+ * todos los sufijos de una clave (los contextos de orden 1..N
+ * del compresor PPMC) están sobre un único camino desde la raíz.
+ *
+ * El contenedor recuerda el último camino recorrido, por lo que
+ * buscar, actualizar o agregar claves que sean sufijos de la
+ * última clave accedida no vuelve a recorrer el trie.
+ *
+ * El consumo de memoria está acotado por memory_limit. Cuando
+ * agregar un elemento superaría ese límite, el contenedor se vacía
+ * por completo antes de agregarlo (el modelo de contextos se
+ * reinicia). Como el vaciado depende sólo de la secuencia de
+ * operaciones, compresor y descompresor lo hacen en el mismo punto.
+ * Se cuenta la memoria reservada por los vectores, no sólo la
+ * ocupada, más la que alocan los valores aparte (ver heap_size_of).
+ * Los vectores crecen según una política propia para que el punto
+ * de vaciado no dependa de la implementación de la STL. Modificar
+ * un valor nunca vacía el contenedor, aunque pase a ocupar más:
+ * el exceso se corrige al agregar el siguiente elemento.
+ */
+template<typename T>
+class trie_container : public container::associative_container<std::string, T> {
+private:
+	typedef container::associative_container<std::string, T> parent;
+
+	struct node {
+		unsigned char c;
+		int first_child;
+		int next_sibling;
+		int value;
+
+		node(unsigned char c) : c(c), first_child(-1), next_sibling(-1), value(-1) {}
+	};
+
+	std::vector<node> nodes;
+	std::vector<T> values;
+	std::size_t node_capacity;
+	std::size_t value_capacity;
+	// Memoria alocada aparte por los valores guardados
+	unsigned int values_heap_size;
+	unsigned int memory_limit;
+
+	// Último camino recorrido: cached_path[d] es el nodo al que se
+	// llega consumiendo los últimos d chars de cached_key
+	std::string cached_key;
+	std::vector<int> cached_path;
+
+	void clear();
+	void replace_value(int index, const T &value);
+	static std::size_t grown_capacity(std::size_t capacity, std::size_t required);
+	void reserve(std::size_t required_nodes, std::size_t required_values);
+	unsigned int memory_usage(std::size_t required_nodes, std::size_t required_values) const;
+	unsigned int memory_usage() const;
+	int find_child(int parent_node, unsigned char c) const;
+	int find_node(const std::string &key, bool create);
+	void inspect_node(int current_node, std::string &reversed_key, container::element_inspector<std::string, T> &inspector);
+public:
+	/**
+	 * Crea una nueva instancia de trie_container vacía que no
+	 * utilizará más de memory_limit bytes
+	 */
+	trie_container(unsigned int memory_limit);
+
+	/**
+	 * Agrega un elemento al contenedor. Valida si el
+	 * elemento está en el contenedor, en cuyo caso eleva
+	 * duplicate_exception.
+	 */
+	void add_element(const std::string &key, const T &value);
+
+	/**
+	 * Modifica un elemento existente en el contenedor.
+	 * Valida que el elemento exista, en caso contrario
+	 * eleva not_found_exception
+	 */
+	void update_element(const std::string &key, const T &value);
+
+	/**
+	 * Modifica un elemento si existe en el contenedor, o
+	 * lo agrega en caso contrario.
+	 */
+	void upsert_element(const std::string &key, const T &value);
+
+	/**
+	 * Elimina un elemento existente en el contenedor.
+	 * Valida que el elemento exista, en caso contrario
+	 * eleva not_found_exception
+	 */
+	void delete_element(const std::string &key);
+
+	/**
+	 * Busca un elemento en el contenedor. Si el elemento
+	 * existe, result.first será true, y result.second será
+	 * una copia del elemento almacenado. En caso contrario,
+	 * result.first será false.
+	 */
+	std::pair<bool, T> search_for_element(const std::string &key);
+
+	/**
+	 * Vuelca el contenido de la estructura de datos en
+	 * un stream dado.
+	 */
+	virtual void dump_to_stream(std::ostream &output);
+
+	/**
+	 * Inspecciona todos los pares clave-valor almacenados en
+	 * el contenedor asociativo utilizando la interface de inspección
+	 * dada
+	 */
+	virtual void inspect(container::element_inspector<std::string, T> &inspector);
+};
+
+template<typename T>
+trie_container<T>::trie_container(unsigned int memory_limit)
+: memory_limit(memory_limit) {
+	clear();
+}
+
+template<typename T>
+void trie_container<T>::add_element(const std::string &key, const T &value) {
+	int existing_node = find_node(key, false);
+	if (existing_node >= 0 && nodes[existing_node].value >= 0)
+		throw typename parent::duplicate_exception();
+
+	// Si en el peor caso (un nodo nuevo por char) nos pasamos
+	// del límite, reiniciamos el contenedor
+	if (memory_usage(nodes.size() + key.size(), values.size() + 1) + heap_size_of(value) > memory_limit)
+		clear();
+
+	// Reservo antes de crear los nodos, así los vectores no
+	// crecen por su cuenta
+	reserve(nodes.size() + key.size(), values.size() + 1);
+	int new_node = find_node(key, true);
+	nodes[new_node].value = values.size();
+	values.push_back(value);
+	values_heap_size += heap_size_of(value);
+}
+
+template<typename T>
+void trie_container<T>::update_element(const std::string &key, const T &value) {
+	int existing_node = find_node(key, false);
+	if (existing_node < 0 || nodes[existing_node].value < 0)
+		throw typename parent::not_found_exception();
+
+	replace_value(nodes[existing_node].value, value);
+}
+
+template<typename T>
+void trie_container<T>::upsert_element(const std::string &key, const T &value) {
+	int existing_node = find_node(key, false);
+	if (existing_node >= 0 && nodes[existing_node].value >= 0) {
+		replace_value(nodes[existing_node].value, value);
+	} else {
+		add_element(key, value);
+	}
+}
+
+template<typename T>
+void trie_container<T>::delete_element(const std::string &key) {
+	int existing_node = find_node(key, false);
+	if (existing_node < 0 || nodes[existing_node].value < 0)
+		throw typename parent::not_found_exception();
+
+	// El nodo y el valor no se liberan hasta que el contenedor
+	// se reinicie; sólo se desengancha el valor de la clave
+	nodes[existing_node].value = -1;
+}
+
+template<typename T>
+std::pair<bool, T> trie_container<T>::search_for_element(const std::string &key) {
+	int existing_node = find_node(key, false);
+	if (existing_node < 0 || nodes[existing_node].value < 0)
+		return std::make_pair(false, T());
+
+	return std::make_pair(true, values[nodes[existing_node].value]);
+}
+
+template<typename T>
+void trie_container<T>::dump_to_stream(std::ostream &output) {
+	struct dumper : public container::element_inspector<std::string, T> {
+		std::ostream &output;
+
+		dumper(std::ostream &output) : output(output) {}
+
+		virtual void inspect(const std::string &key, const T &value) {
+			output << "(" << key << "," << value << ")" << std::endl;
+		}
+	};
+
+	output << "TRIE DE CONTEXTOS" << std::endl;
+	output << "---- -- --------" << std::endl;
+	output << "Nodos: " << nodes.size() << std::endl;
+	output << "Memoria utilizada (b): " << memory_usage() << " de " << memory_limit << std::endl;
+	output << "---Elementos---: " << std::endl;
+
+	dumper d(output);
+	inspect(d);
+}
+
+template<typename T>
+void trie_container<T>::inspect(container::element_inspector<std::string, T> &inspector) {
+	std::string reversed_key;
+	inspect_node(0, reversed_key, inspector);
+}
+
+template<typename T>
+void trie_container<T>::clear() {
+	// Libero la memoria reservada, que si no seguiría contando
+	std::vector<node>().swap(nodes);
+	std::vector<T>().swap(values);
+	node_capacity = 0;
+	value_capacity = 0;
+	values_heap_size = 0;
+	reserve(1, 0);
+	nodes.push_back(node(0));
+
+	cached_key.clear();
+	cached_path.assign(1, 0);
+}
+
+template<typename T>
+void trie_container<T>::replace_value(int index, const T &value) {
+	values_heap_size -= heap_size_of(values[index]);
+	values[index] = value;
+	values_heap_size += heap_size_of(value);
+}
+
+template<typename T>
+std::size_t trie_container<T>::grown_capacity(std::size_t capacity, std::size_t required) {
+	while (capacity < required)
+		capacity += capacity / 2 + 1;
+	return capacity;
+}
+
+template<typename T>
+void trie_container<T>::reserve(std::size_t required_nodes, std::size_t required_values) {
+	node_capacity = grown_capacity(node_capacity, required_nodes);
+	value_capacity = grown_capacity(value_capacity, required_values);
+	nodes.reserve(node_capacity);
+	values.reserve(value_capacity);
+}
+
+template<typename T>
+unsigned int trie_container<T>::memory_usage(std::size_t required_nodes, std::size_t required_values) const {
+	return
+		grown_capacity(node_capacity, required_nodes) * sizeof(node) +
+		grown_capacity(value_capacity, required_values) * sizeof(T) +
+		values_heap_size;
+}
+
+template<typename T>
+unsigned int trie_container<T>::memory_usage() const {
+	return memory_usage(nodes.size(), values.size());
+}
+
+template<typename T>
+int trie_container<T>::find_child(int parent_node, unsigned char c) const {
+	for (int child = nodes[parent_node].first_child; child >= 0; child = nodes[child].next_sibling) {
+		if (nodes[child].c == c)
+			return child;
+	}
+	return -1;
+}
+
+template<typename T>
+int trie_container<T>::find_node(const std::string &key, bool create) {
+	// Si ni la clave ni la última recorrida es sufijo de la otra,
+	// el camino recordado no sirve y hay que empezar desde la raíz
+	std::string::size_type common_size = std::min(key.size(), cached_key.size());
+	if (key.compare(key.size() - common_size, common_size, cached_key, cached_key.size() - common_size, common_size) != 0) {
+		cached_path.assign(1, 0);
+		cached_key = key;
+	} else if (key.size() > cached_key.size()) {
+		cached_key = key;
+	}
+
+	// Extiendo el camino recordado hasta la profundidad pedida
+	while (cached_path.size() <= key.size()) {
+		int current_node = cached_path.back();
+		unsigned char c = key[key.size() - cached_path.size()];
+		int child = find_child(current_node, c);
+		if (child < 0) {
+			if (!create)
+				return -1;
+
+			child = nodes.size();
+			nodes.push_back(node(c));
+			nodes[child].next_sibling = nodes[current_node].first_child;
+			nodes[current_node].first_child = child;
+		}
+		cached_path.push_back(child);
+	}
+
+	return cached_path[key.size()];
+}
+
+template<typename T>
+void trie_container<T>::inspect_node(int current_node, std::string &reversed_key, container::element_inspector<std::string, T> &inspector) {
+	if (nodes[current_node].value >= 0) {
+		std::string key(reversed_key.rbegin(), reversed_key.rend());
+		inspector.inspect(key, values[nodes[current_node].value]);
+	}
+
+	for (int child = nodes[current_node].first_child; child >= 0; child = nodes[child].next_sibling) {
+		reversed_key += nodes[child].c;
+		inspect_node(child, reversed_key, inspector);
+		reversed_key.erase(reversed_key.size() - 1);
+	}
+}
+
+};
+
+#endif // __TRIE_TRIE_CONTAINER_H_INCLUDED__